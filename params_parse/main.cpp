@@ -0,0 +1,114 @@
+#include "pipeline.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+struct Options
+{
+    Format format = Format::Json;
+    unsigned workers = std::max(1u, std::thread::hardware_concurrency());
+    std::string input = "-";
+    std::string output = "-";
+};
+
+void PrintUsage()
+{
+    std::fputs("usage: params-parse [--format json|tsv] [--jobs N] [INPUT [OUTPUT]]\n", stderr);
+}
+
+bool ParseArguments(int argc, char *argv[], Options &options)
+{
+    std::vector<std::string_view> files;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if ((arg == "--format" || arg == "--jobs") && i + 1 == argc) {
+            return false;
+        }
+        if (arg == "--format") {
+            const std::string_view format = argv[++i];
+            if (format == "json") {
+                options.format = Format::Json;
+            } else if (format == "tsv") {
+                options.format = Format::Tsv;
+            } else {
+                return false;
+            }
+        } else if (arg == "--jobs") {
+            options.workers = std::max(1, std::atoi(argv[++i]));
+        } else if (arg.starts_with("--")) {
+            return false;
+        } else {
+            files.push_back(arg);
+        }
+    }
+    if (files.size() > 2) {
+        return false;
+    }
+    if (!files.empty()) {
+        options.input = files[0];
+    }
+    if (files.size() == 2) {
+        options.output = files[1];
+    }
+    return true;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    Options options;
+    if (!ParseArguments(argc, argv, options)) {
+        PrintUsage();
+        return 2;
+    }
+
+    std::FILE *input = options.input == "-" ? stdin : std::fopen(options.input.c_str(), "rb");
+    if (input == nullptr) {
+        std::fprintf(stderr, "params-parse: cannot open %s: %s\n", options.input.c_str(), std::strerror(errno));
+        return 2;
+    }
+    std::FILE *output = options.output == "-" ? stdout : std::fopen(options.output.c_str(), "wb");
+    if (output == nullptr) {
+        std::fprintf(stderr, "params-parse: cannot open %s: %s\n", options.output.c_str(), std::strerror(errno));
+        return 2;
+    }
+
+    const auto started = std::chrono::steady_clock::now();
+
+    const auto totals = ConvertStream(input, output, stderr, options.format, options.workers);
+
+    const bool read_failed = std::ferror(input) != 0;
+    const bool write_failed = std::ferror(output) != 0;
+    if (input != stdin) {
+        std::fclose(input);
+    }
+    if (output != stdout) {
+        std::fclose(output);
+    }
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - started;
+    const double seconds = std::max(elapsed.count(), 1e-9);
+    std::fprintf(stderr,
+                 "%zu lines (%zu failed), %zu bytes in %.3f s: %.0f lines/s, %.1f MB/s\n",
+                 totals.lines, totals.failed_lines, totals.bytes, seconds,
+                 static_cast<double>(totals.lines) / seconds,
+                 static_cast<double>(totals.bytes) / seconds / 1e6);
+
+    if (read_failed || write_failed) {
+        std::fputs("params-parse: I/O error\n", stderr);
+        return 2;
+    }
+    return totals.failed_lines == 0 ? 0 : 1;
+}
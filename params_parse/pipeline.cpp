@@ -0,0 +1,239 @@
+#include "pipeline.h"
+#include "bounded_queue.h"
+
+#include <params_parser/params_parser.h>
+#include <params_parser/parser_exceptions.h>
+
+#include <algorithm>
+#include <map>
+#include <semaphore>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+struct Block
+{
+    std::size_t index;
+    std::size_t first_line;
+    std::string text;
+};
+
+struct ConvertedBlock
+{
+    std::size_t index;
+    std::size_t lines;
+    std::size_t failed_lines;
+    std::string output;
+    std::string errors;
+};
+
+void AppendJsonString(std::string &out, std::string_view text)
+{
+    out.push_back('"');
+    for (const char c : text) {
+        switch (c) {
+            case '"':
+                out.append("\\\"");
+                break;
+            case '\\':
+                out.append("\\\\");
+                break;
+            case '\n':
+                out.append("\\n");
+                break;
+            case '\t':
+                out.append("\\t");
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[7];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out.append(escaped);
+                } else {
+                    out.push_back(c);
+                }
+        }
+    }
+    out.push_back('"');
+}
+
+void AppendTsvField(std::string &out, std::string_view text)
+{
+    for (const char c : text) {
+        switch (c) {
+            case '\\':
+                out.append("\\\\");
+                break;
+            case '\t':
+                out.append("\\t");
+                break;
+            case '\n':
+                out.append("\\n");
+                break;
+            case '\r':
+                out.append("\\r");
+                break;
+            default:
+                out.push_back(c);
+        }
+    }
+}
+
+void AppendJson(std::string &out, const std::map<std::string, std::string> &params)
+{
+    out.push_back('{');
+    bool first = true;
+    for (const auto &[key, value] : params) {
+        if (!first) {
+            out.push_back(',');
+        }
+        first = false;
+        AppendJsonString(out, key);
+        out.push_back(':');
+        AppendJsonString(out, value);
+    }
+    out.append("}\n");
+}
+
+void AppendTsv(std::string &out, std::size_t line, const std::map<std::string, std::string> &params)
+{
+    for (const auto &[key, value] : params) {
+        out.append(std::to_string(line));
+        out.push_back('\t');
+        AppendTsvField(out, key);
+        out.push_back('\t');
+        AppendTsvField(out, value);
+        out.push_back('\n');
+    }
+}
+
+ConvertedBlock Convert(const Block &block, Format format)
+{
+    ConvertedBlock converted{block.index, 0, 0, {}, {}};
+    converted.output.reserve(block.text.size() * 3 / 2);
+    // JSON strings must be valid UTF-8, so a line that is not becomes `null` like any other bad line.
+    const ParseOptions options{.validate_utf8 = format == Format::Json, .limits = {}};
+
+    std::string_view rest = block.text;
+    while (!rest.empty()) {
+        const auto end = std::min(rest.find('\n'), rest.size());
+        const auto line = rest.substr(0, end);
+        rest.remove_prefix(std::min(end + 1, rest.size()));
+
+        const auto line_number = block.first_line + converted.lines++;
+        try {
+            const auto params = ParseParamsAs<SlashSyntax>(line, options);
+            if (format == Format::Json) {
+                AppendJson(converted.output, params);
+            } else {
+                AppendTsv(converted.output, line_number, params);
+            }
+        } catch (const ParsingException &ex) {
+            converted.failed_lines++;
+            converted.errors.append("line " + std::to_string(line_number) + ": " + ex.what() + "\n");
+            if (format == Format::Json) {
+                converted.output.append("null\n");
+            }
+        }
+    }
+    return converted;
+}
+
+// Every pushed block takes a ticket, which the writer gives back once the block is written.
+void ReadBlocks(std::FILE *input, std::size_t block_size, BoundedQueue<Block> &blocks, std::counting_semaphore<> &tickets,
+                Totals &totals)
+{
+    std::size_t index = 0;
+    std::size_t line = 1;
+    std::string carry;
+    while (true) {
+        std::string text = std::move(carry);
+        carry.clear();
+        const auto kept = text.size();
+        text.resize(kept + block_size);
+        const auto read = std::fread(text.data() + kept, 1, block_size, input);
+        totals.bytes += read;
+        text.resize(kept + read);
+
+        if (read == 0) {
+            if (!text.empty()) {
+                tickets.acquire();
+                blocks.Push(Block{index++, line, std::move(text)});
+            }
+            return;
+        }
+
+        const auto last_newline = text.rfind('\n');
+        if (last_newline == std::string::npos) {
+            // Not a single complete line yet: keep on accumulating.
+            carry = std::move(text);
+            continue;
+        }
+        carry.assign(text, last_newline + 1);
+        text.resize(last_newline + 1);
+
+        const auto lines = static_cast<std::size_t>(std::ranges::count(text, '\n'));
+        tickets.acquire();
+        blocks.Push(Block{index++, line, std::move(text)});
+        line += lines;
+    }
+}
+
+void WriteBlocks(std::FILE *output, std::FILE *errors, BoundedQueue<ConvertedBlock> &converted,
+                 std::counting_semaphore<> &tickets, Totals &totals)
+{
+    std::map<std::size_t, ConvertedBlock> pending;
+    std::size_t next = 0;
+    while (auto block = converted.Pop()) {
+        pending.emplace(block->index, std::move(*block));
+        for (auto it = pending.find(next); it != pending.end(); it = pending.find(++next)) {
+            const auto &ready = it->second;
+            std::fwrite(ready.output.data(), 1, ready.output.size(), output);
+            std::fputs(ready.errors.c_str(), errors);
+            totals.lines += ready.lines;
+            totals.failed_lines += ready.failed_lines;
+            pending.erase(it);
+            tickets.release();
+        }
+    }
+    std::fflush(output);
+}
+
+}
+
+Totals ConvertStream(std::FILE *input, std::FILE *output, std::FILE *errors, Format format, unsigned workers,
+                     std::size_t block_size)
+{
+    workers = std::max(1u, workers);
+    // Blocks finish out of order, so the queues alone do not bound the blocks waiting for the writer.
+    std::counting_semaphore<> tickets(2 * workers);
+    BoundedQueue<Block> blocks(2 * workers);
+    BoundedQueue<ConvertedBlock> converted(2 * workers);
+    Totals totals;
+
+    std::thread reader([&] {
+        ReadBlocks(input, block_size, blocks, tickets, totals);
+        blocks.Close();
+    });
+    std::thread writer([&] { WriteBlocks(output, errors, converted, tickets, totals); });
+    std::vector<std::thread> parsers;
+    for (unsigned i = 0; i < workers; ++i) {
+        parsers.emplace_back([&] {
+            while (const auto block = blocks.Pop()) {
+                converted.Push(Convert(*block, format));
+            }
+        });
+    }
+
+    reader.join();
+    for (auto &parser : parsers) {
+        parser.join();
+    }
+    converted.Close();
+    writer.join();
+    return totals;
+}
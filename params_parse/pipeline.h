@@ -0,0 +1,38 @@
+#ifndef PIPELINE_H_INCLUDED
+#define PIPELINE_H_INCLUDED
+
+#include <cstddef>
+#include <cstdio>
+
+/*
+ * Converts a stream of parameter lines to JSON Lines or TSV.
+ *
+ * reader thread -> [blocks] -> parser workers -> [converted blocks] -> writer thread
+ *
+ * The reader cuts the input into large blocks ending on a line boundary, so workers
+ * never share a line, and the writer puts the converted blocks back into input order.
+ */
+
+constexpr std::size_t BLOCK_SIZE = 4 << 20;
+
+enum class Format
+{
+    // One JSON object per line; a line that fails to parse or is not valid UTF-8 becomes `null`.
+    Json,
+    // One `line<TAB>key<TAB>value` row per parameter.
+    Tsv,
+};
+
+struct Totals
+{
+    std::size_t bytes = 0;
+    std::size_t lines = 0;
+    std::size_t failed_lines = 0;
+};
+
+// Runs the whole pipeline with `workers` parser threads; parse errors are written to `errors`
+// with their line numbers. At most 2 * workers blocks of about `block_size` bytes are held at once.
+Totals ConvertStream(std::FILE* input, std::FILE* output, std::FILE* errors, Format format, unsigned workers,
+                     std::size_t block_size = BLOCK_SIZE);
+
+#endif // PIPELINE_H_INCLUDED
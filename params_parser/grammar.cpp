@@ -0,0 +1,279 @@
+#include "grammar.h"
+#include "parser_exceptions.h"
+
+#include <algorithm>
+
+namespace parse
+{
+
+namespace
+{
+
+template <typename Syntax>
+void SkipWhitespaces(BasicSource<Syntax> &source)
+{
+    if (source.GetCurrent().token == Token::Whitespaces) {
+        source.Next();
+    }
+}
+
+template <typename Syntax>
+std::string_view Key(BasicSource<Syntax> &source)
+{
+    const auto &limits = source.GetOptions().limits;
+    const auto prefix = source.ExpectOneOf({Token::Prefix});
+    if (source.CountParameter() > limits.max_parameters) {
+        source.Fail(ParsingError{ParsingErrorKind::LimitExceeded, source.GetBounds(prefix.value)});
+        return {};
+    }
+    const auto key = source.GetCurrent();
+    if (key.token != Token::Word) {
+        source.Fail(ParsingError{
+            ParsingErrorKind::MissingParameterName,
+            source.GetBounds(prefix.value)
+        });
+        return {};
+    }
+    if (key.value.size() > limits.max_key_length) {
+        source.Fail(ParsingError{ParsingErrorKind::LimitExceeded, source.GetBounds(key.value)});
+        return {};
+    }
+    source.Next();
+    return key.value;
+}
+
+// Escaped sequences before the current token, which the source has already read ahead.
+template <typename Syntax>
+std::size_t EscapedBefore(const BasicSource<Syntax> &source)
+{
+    return source.GetEscapedCount() - (source.GetCurrent().token == Token::EscapedSequence ? 1 : 0);
+}
+
+template <typename Syntax>
+void SkipMany(BasicSource<Syntax> &source, std::initializer_list<Token> allowed)
+{
+    while (source.CheckOneOf(allowed)) {
+        source.Next();
+    }
+}
+
+template <typename Syntax>
+std::string_view UnquotedText(BasicSource<Syntax> &source)
+{
+    const auto view = source.GetCurrent();
+    switch (view.token) {
+        case Token::Prefix:
+            // Only whitespace separates a value from the next parameter, so `-offset:-5` is a value.
+            if constexpr (IS_SEPARATED_BY_WHITESPACE<Syntax>) {
+                return source.Since(view.value);
+            }
+            [[fallthrough]];
+        case Token::EscapedSequence:
+            [[fallthrough]];
+        case Token::Separator:
+            [[fallthrough]];
+        case Token::Word:
+            SkipMany(source, {
+                Token::Word,
+                Token::EscapedSequence,
+                Token::Prefix,
+                Token::Separator,
+            });
+            return source.Since(view.value);
+        case Token::End:
+            [[fallthrough]];
+        case Token::Whitespaces:
+            return source.Since(view.value);
+        default:
+            throw std::exception();
+    }
+}
+
+template <typename Syntax>
+std::string_view QuotedText(BasicSource<Syntax> &source)
+{
+    auto open_quote = source.GetCurrent();
+    source.Next();
+
+    SkipMany(source, {
+        Token::Prefix,
+        Token::Separator,
+        Token::Word,
+        Token::Whitespaces,
+        Token::EscapedSequence,
+    });
+
+    switch (source.GetCurrent().token) {
+        case Token::Quote:
+            source.Next();
+            return source.Since(open_quote.value);
+        default:
+            source.Fail(ParsingError{ParsingErrorKind::MissingQuotes, source.ToEnd(open_quote.value)});
+            return {};
+    }
+}
+
+template <typename Syntax>
+std::string_view Value(BasicSource<Syntax> &source)
+{
+    switch (source.GetCurrent().token) {
+        case Token::Quote:
+            return QuotedText(source);
+        default:
+            return UnquotedText(source);
+    }
+}
+
+template <typename Syntax>
+void CheckValueLimits(BasicSource<Syntax> &source, std::string_view value, std::size_t escaped)
+{
+    const auto &limits = source.GetOptions().limits;
+    // Every escaped sequence is two bytes long.
+    if (value.size() > limits.max_value_length || escaped * 2 * 100 > limits.max_escape_percent * value.size()) {
+        source.Fail(ParsingError{ParsingErrorKind::LimitExceeded, source.GetBounds(value)});
+    }
+}
+
+template <typename Syntax>
+RawParameter Param(BasicSource<Syntax> &source)
+{
+    const auto key = Key(source);
+
+    switch (source.GetCurrent().token) {
+        case Token::End:
+            return RawParameter{key, source.Since(source.GetCurrent().value)};
+        case Token::Whitespaces:
+            if constexpr (!IS_SEPARATED_BY_WHITESPACE<Syntax>) {
+                return RawParameter{key, source.Since(source.GetCurrent().value)};
+            }
+            [[fallthrough]];
+        case Token::Separator: {
+            source.Next();
+            const auto escaped_before = EscapedBefore(source);
+            const auto value = Value(source);
+            CheckValueLimits(source, value, EscapedBefore(source) - escaped_before);
+            return RawParameter{key, value};
+        }
+        default:
+            source.Fail(ParsingError{
+                ParsingErrorKind::UnexpectedValue,
+                source.GetBounds(source.GetCurrent().value)
+            });
+            return {};
+    }
+}
+
+}
+
+template <typename Syntax>
+std::optional<RawParameter> TryNextParam(BasicSource<Syntax> &source)
+{
+    /*
+     * Params -> Param*
+     * Param -> Token::WhiteSpaces? <> Key <> (Separator <> Value)?
+     * Key -> Token::Prefix <> Token::Word
+     * Separator -> Token::Whitespaces | Token::Separator, depending on the syntax
+     * Value -> NoQuotedText | QuotedText
+     * NoQuotedText
+     *      -> ((Token::EscapedSequence | Token::Word | Token::Separator | Token::Prefix*)
+     *      <>  (Token::EscapedSequence | Token::Word | Token::Separator | Token::Prefix)*)?
+     *      (*) only when the separator is not whitespace
+     * QuotedText
+     *      -> Token::Quote
+     *      <>  (Token::EscapedSequence | Token::Word | Token::Separator | Token::Prefix | Token::Whitespaces)*
+     *      <>  Token::Quote
+     */
+    SkipWhitespaces(source);
+    switch (source.GetCurrent().token) {
+        case Token::End:
+            return std::nullopt;
+        case Token::Prefix: {
+            // After an error the rest of the grammar only sees the end of input.
+            const auto param = Param(source);
+            return source.GetError() ? std::nullopt : std::optional(param);
+        }
+        default:
+            const auto begin = source.GetCurrent().value;
+            Value(source);
+            source.Fail(ParsingError{ParsingErrorKind::UnexpectedValue,
+                                     source.GetBounds(source.Since(begin))});
+            return std::nullopt;
+    }
+}
+
+template <typename Syntax>
+std::optional<RawParameter> NextParam(BasicSource<Syntax> &source)
+{
+    auto param = TryNextParam(source);
+    if (const auto &error = source.GetError()) {
+        throw *error;
+    }
+    return param;
+}
+
+template <typename Syntax>
+void SkipToNextParam(BasicSource<Syntax> &source)
+{
+    while (!source.CheckOneOf({Token::Prefix, Token::End})) {
+        source.Next();
+    }
+}
+
+template <typename Syntax>
+ParsingError SpecifiedTwice(const BasicSource<Syntax> &source, std::string_view key)
+{
+    auto bounds = source.GetBounds(key);
+    bounds.begin -= Syntax::prefix.size();
+    return ParsingError{ParsingErrorKind::SpecifiedTwiceParameter, bounds};
+}
+
+template <typename Syntax>
+std::string Unescape(std::string_view raw_value)
+{
+    std::string result(raw_value.size(), '\0');
+    result.resize(UnescapeTo<Syntax>(raw_value, result));
+    return result;
+}
+
+template <typename Syntax>
+std::size_t UnescapeTo(std::string_view raw_value, std::span<char> out)
+{
+    std::size_t size = 0;
+    for (BasicSource<Syntax> source(raw_value); source.GetCurrent().token != Token::End; source.Next()) {
+        if (source.GetCurrent().token == Token::Quote) {
+            continue;
+        }
+        const auto text = source.GetCurrent().Unescaped();
+        if (size + text.size() <= out.size()) {
+            std::ranges::copy(text, out.begin() + size);
+        }
+        size += text.size();
+    }
+    return size;
+}
+
+template std::optional<RawParameter> TryNextParam(BasicSource<SlashSyntax> &);
+template std::optional<RawParameter> TryNextParam(BasicSource<DoubleDashSyntax> &);
+template std::optional<RawParameter> TryNextParam(BasicSource<DashColonSyntax> &);
+
+template std::optional<RawParameter> NextParam(BasicSource<SlashSyntax> &);
+template std::optional<RawParameter> NextParam(BasicSource<DoubleDashSyntax> &);
+template std::optional<RawParameter> NextParam(BasicSource<DashColonSyntax> &);
+
+template void SkipToNextParam(BasicSource<SlashSyntax> &);
+template void SkipToNextParam(BasicSource<DoubleDashSyntax> &);
+template void SkipToNextParam(BasicSource<DashColonSyntax> &);
+
+template ParsingError SpecifiedTwice(const BasicSource<SlashSyntax> &, std::string_view);
+template ParsingError SpecifiedTwice(const BasicSource<DoubleDashSyntax> &, std::string_view);
+template ParsingError SpecifiedTwice(const BasicSource<DashColonSyntax> &, std::string_view);
+
+template std::string Unescape<SlashSyntax>(std::string_view);
+template std::string Unescape<DoubleDashSyntax>(std::string_view);
+template std::string Unescape<DashColonSyntax>(std::string_view);
+
+template std::size_t UnescapeTo<SlashSyntax>(std::string_view, std::span<char>);
+template std::size_t UnescapeTo<DoubleDashSyntax>(std::string_view, std::span<char>);
+template std::size_t UnescapeTo<DashColonSyntax>(std::string_view, std::span<char>);
+
+}
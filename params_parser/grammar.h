@@ -0,0 +1,50 @@
+#ifndef PARAMS_GRAMMAR_H_INCLUDED
+#define PARAMS_GRAMMAR_H_INCLUDED
+
+#include "token.h"
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace parse
+{
+
+struct RawParameter
+{
+    std::string_view key;
+    // Value exactly as written: surrounding quotes and escape characters are kept.
+    std::string_view value;
+};
+
+// Reads the next parameter without unescaping its value.
+// Returns std::nullopt once the whole input is consumed, throws ParsingError on malformed input.
+template <typename Syntax>
+std::optional<RawParameter> NextParam(BasicSource<Syntax> &source);
+
+// Same as NextParam, but never throws: malformed input also returns std::nullopt,
+// with the error left in source.GetError().
+template <typename Syntax>
+std::optional<RawParameter> TryNextParam(BasicSource<Syntax> &source);
+
+// Skips tokens up to the prefix of the next parameter or the end of input.
+template <typename Syntax>
+void SkipToNextParam(BasicSource<Syntax> &source);
+
+// Error for a repeated key, positioned on the key with its prefix.
+template <typename Syntax>
+ParsingError SpecifiedTwice(const BasicSource<Syntax> &source, std::string_view key);
+
+template <typename Syntax = SlashSyntax>
+std::string Unescape(std::string_view raw_value);
+
+// Writes the unescaped value to `out` if it fits and returns its size either way.
+// The unescaped value is never longer than the raw one.
+template <typename Syntax = SlashSyntax>
+std::size_t UnescapeTo(std::string_view raw_value, std::span<char> out);
+
+}
+
+#endif // PARAMS_GRAMMAR_H_INCLUDED
@@ -0,0 +1,256 @@
+#include "incremental_parser.h"
+#include "grammar.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+
+constexpr std::size_t NO_SPAN = std::numeric_limits<std::size_t>::max();
+
+std::string_view Slice(std::string_view text, const ParamsChunk &chunk)
+{
+    return text.substr(chunk.begin, chunk.end - chunk.begin);
+}
+
+// Turns offsets from the start of a text of `size` bytes into offsets from its end and back.
+ParamsChunk Mirror(ParamsChunk chunk, std::size_t size)
+{
+    return ParamsChunk{size - chunk.begin, size - chunk.end};
+}
+
+ParameterSpans Mirror(const ParameterSpans &spans, std::size_t size)
+{
+    return ParameterSpans{Mirror(spans.param, size), Mirror(spans.key, size), Mirror(spans.value, size)};
+}
+
+}
+
+bool IncrementalParser::ByPosition::operator()(SpanId lhs, SpanId rhs) const
+{
+    return parser->SpansOf(lhs).param.begin < parser->SpansOf(rhs).param.begin;
+}
+
+IncrementalParser::IncrementalParser(std::string_view params)
+{
+    Edit(0, 0, params);
+}
+
+void IncrementalParser::Edit(std::size_t offset, std::size_t removed, std::string_view inserted)
+{
+    if (offset > m_text.size() || removed > m_text.size() - offset) {
+        throw std::out_of_range("IncrementalParser::Edit: edit is outside of the text");
+    }
+    ++m_edits;
+
+    // A parameter may look one token past its end, so the restart point keeps a byte of distance from the edit.
+    MoveGap(offset);
+    const std::size_t restart = m_beforeGap.empty() ? 0 : m_records[m_beforeGap.back()].spans.param.end;
+
+    // Parameters starting in the removed text are parsed again anyway, and once it is spliced
+    // their offsets from the end would no longer keep them in order with the rest of the index.
+    std::vector<Keys::iterator> touched;
+    while (!m_afterGap.empty() && SpansOf(m_afterGap.back()).param.begin < offset + removed) {
+        RemoveSpans(m_afterGap.back(), touched);
+        m_afterGap.pop_back();
+    }
+    m_text.replace(offset, removed, inserted);
+
+    std::vector<ParameterSpans> fresh;
+    std::size_t position = restart;
+    bool resynchronized = false;
+    std::optional<ParsingError> syntax_error;
+    try {
+        Source source(m_text, position);
+        while (!resynchronized) {
+            // Past the edit the old and the new parse agree from any common parameter boundary on,
+            // and the old parameters before it are replaced by the fresh ones.
+            while (!m_afterGap.empty() && SpansOf(m_afterGap.back()).param.end <= position) {
+                resynchronized = SpansOf(m_afterGap.back()).param.end == position;
+                RemoveSpans(m_afterGap.back(), touched);
+                m_afterGap.pop_back();
+                if (resynchronized) {
+                    break;
+                }
+            }
+            if (resynchronized) {
+                break;
+            }
+            const auto param = parse::NextParam(source);
+            if (!param) {
+                break;
+            }
+            const auto key = source.GetBounds(param->key);
+            const auto value = source.GetBounds(param->value);
+            fresh.push_back(ParameterSpans{{key.begin - 1, value.end}, key, value});
+            position = value.end;
+        }
+    } catch (const ParsingError &error) {
+        syntax_error = error;
+    }
+
+    if (!resynchronized) {
+        for (; !m_afterGap.empty(); m_afterGap.pop_back()) {
+            RemoveSpans(m_afterGap.back(), touched);
+        }
+        m_syntaxError = syntax_error;
+        if (m_syntaxError) {
+            m_syntaxError->position = Mirror(m_syntaxError->position, m_text.size());
+        }
+    }
+    m_lastReparsed = ParamsChunk{restart, syntax_error ? syntax_error->position.end : position};
+
+    for (const auto &spans : fresh) {
+        AddSpans(spans, touched);
+    }
+    UpdateValues(touched);
+    UpdateError();
+}
+
+ParameterSpans IncrementalParser::SpansOf(SpanId id) const
+{
+    const auto &record = m_records[id];
+    return record.after_gap ? Mirror(record.spans, m_text.size()) : record.spans;
+}
+
+void IncrementalParser::Flip(SpanId id)
+{
+    auto &record = m_records[id];
+    record.spans = Mirror(record.spans, m_text.size());
+    record.after_gap = !record.after_gap;
+}
+
+void IncrementalParser::MoveGap(std::size_t offset)
+{
+    while (!m_beforeGap.empty() && m_records[m_beforeGap.back()].spans.param.end + 1 >= offset) {
+        Flip(m_beforeGap.back());
+        m_afterGap.push_back(m_beforeGap.back());
+        m_beforeGap.pop_back();
+    }
+    while (!m_afterGap.empty() && SpansOf(m_afterGap.back()).param.end + 1 < offset) {
+        Flip(m_afterGap.back());
+        m_beforeGap.push_back(m_afterGap.back());
+        m_afterGap.pop_back();
+    }
+}
+
+void IncrementalParser::AddSpans(const ParameterSpans &spans, std::vector<Keys::iterator> &touched)
+{
+    const auto key_text = Slice(m_text, spans.key);
+    auto key = m_keys.find(key_text);
+    if (key == m_keys.end()) {
+        key = m_keys.emplace(std::string(key_text), KeyEntry{Occurrences(ByPosition{this}), NO_SPAN}).first;
+    }
+
+    const Record record{spans, false, key, m_edits};
+    SpanId id = m_records.size();
+    if (m_freeRecords.empty()) {
+        m_records.push_back(record);
+    } else {
+        id = m_freeRecords.back();
+        m_freeRecords.pop_back();
+        m_records[id] = record;
+    }
+    m_beforeGap.push_back(id);
+
+    auto &occurrences = key->second.occurrences;
+    ForgetSecondOccurrence(occurrences);
+    occurrences.insert(id);
+    RememberSecondOccurrence(occurrences);
+    touched.push_back(key);
+}
+
+void IncrementalParser::RemoveSpans(SpanId id, std::vector<Keys::iterator> &touched)
+{
+    const auto key = m_records[id].key;
+    auto &occurrences = key->second.occurrences;
+    ForgetSecondOccurrence(occurrences);
+    occurrences.erase(id);
+    RememberSecondOccurrence(occurrences);
+    touched.push_back(key);
+    m_freeRecords.push_back(id);
+}
+
+void IncrementalParser::ForgetSecondOccurrence(const Occurrences &occurrences)
+{
+    if (occurrences.size() >= 2) {
+        m_secondOccurrences.erase(*std::next(occurrences.begin()));
+    }
+}
+
+void IncrementalParser::RememberSecondOccurrence(const Occurrences &occurrences)
+{
+    if (occurrences.size() >= 2) {
+        m_secondOccurrences.insert(*std::next(occurrences.begin()));
+    }
+}
+
+void IncrementalParser::UpdateValues(std::vector<Keys::iterator> &touched)
+{
+    std::ranges::sort(touched, std::less<>{}, [](Keys::iterator key) { return &*key; });
+    const auto duplicates = std::ranges::unique(touched);
+    touched.erase(duplicates.begin(), duplicates.end());
+
+    for (const auto key : touched) {
+        auto &entry = key->second;
+        if (entry.occurrences.empty()) {
+            m_params.erase(key->first);
+            m_keys.erase(key);
+            continue;
+        }
+        // A record freed by this edit may have been reused for a fresh parameter of the same key.
+        const auto first = *entry.occurrences.begin();
+        if (first != entry.value_from || m_records[first].edit == m_edits) {
+            entry.value_from = first;
+            m_params.insert_or_assign(key->first, parse::Unescape(Slice(m_text, SpansOf(first).value)));
+        }
+    }
+}
+
+void IncrementalParser::UpdateError()
+{
+    // Every parameter precedes a syntax error, so the first repeated key is the one ParseParams would report.
+    if (!m_secondOccurrences.empty()) {
+        const auto spans = SpansOf(*m_secondOccurrences.begin());
+        m_error = ParsingError{ParsingErrorKind::SpecifiedTwiceParameter, {spans.param.begin, spans.key.end}};
+    } else if (m_syntaxError) {
+        m_error = ParsingError{m_syntaxError->kind, Mirror(m_syntaxError->position, m_text.size())};
+    } else {
+        m_error.reset();
+    }
+}
+
+const std::string &IncrementalParser::GetText() const
+{
+    return m_text;
+}
+
+std::vector<ParameterSpans> IncrementalParser::GetSpans() const
+{
+    std::vector<ParameterSpans> spans;
+    spans.reserve(m_beforeGap.size() + m_afterGap.size());
+    for (const auto id : m_beforeGap) {
+        spans.push_back(SpansOf(id));
+    }
+    for (auto id = m_afterGap.rbegin(); id != m_afterGap.rend(); ++id) {
+        spans.push_back(SpansOf(*id));
+    }
+    return spans;
+}
+
+const std::optional<ParsingError> &IncrementalParser::GetError() const
+{
+    return m_error;
+}
+
+const std::map<std::string, std::string> &IncrementalParser::GetParams() const
+{
+    return m_params;
+}
+
+ParamsChunk IncrementalParser::GetLastReparsed() const
+{
+    return m_lastReparsed;
+}
@@ -0,0 +1,108 @@
+#ifndef INCREMENTAL_PARSER_H_INCLUDED
+#define INCREMENTAL_PARSER_H_INCLUDED
+
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "parser_exceptions.h"
+
+struct ParameterSpans
+{
+    ParamsChunk param;  // from the slash to the end of the value
+    ParamsChunk key;
+    ParamsChunk value;  // as written, including quotes
+};
+
+// Keeps the parse of a parameters string up to date while it is being edited.
+// An edit re-parses only from the last parameter unaffected by it until the parameter
+// boundaries line up with the previous parse again; the rest of the result is reused.
+//
+// Spans are split at a gap that follows the edits: the ones before it are stored as offsets
+// from the start of the text and the ones after it as offsets from the end, so an edit moves
+// no span it does not re-parse. Apart from splicing the text, an edit costs time in the size of
+// the re-parsed part and in the number of parameters between it and the previous edit.
+class IncrementalParser
+{
+public:
+    explicit IncrementalParser(std::string_view params = "");
+
+    // The key index refers back to the parser, so it stays where it was created.
+    IncrementalParser(const IncrementalParser&) = delete;
+    IncrementalParser& operator=(const IncrementalParser&) = delete;
+
+    // Replaces `removed` bytes at `offset` with `inserted`.
+    void Edit(std::size_t offset, std::size_t removed, std::string_view inserted);
+
+    const std::string& GetText() const;
+    // Built on every call, in text order.
+    std::vector<ParameterSpans> GetSpans() const;
+
+    // The error ParseParams would throw for the current text, if any.
+    // While it is set, the spans and values cover only the parameters parsed so far,
+    // and a repeated key keeps the value of its first occurrence.
+    const std::optional<ParsingError>& GetError() const;
+    const std::map<std::string, std::string>& GetParams() const;
+
+    // The part of the current text the last edit parsed again.
+    ParamsChunk GetLastReparsed() const;
+
+private:
+    using SpanId = std::size_t;
+
+    struct ByPosition
+    {
+        const IncrementalParser* parser = nullptr;
+
+        bool operator()(SpanId lhs, SpanId rhs) const;
+    };
+
+    using Occurrences = std::set<SpanId, ByPosition>;
+
+    struct KeyEntry
+    {
+        Occurrences occurrences;
+        SpanId value_from;  // the occurrence m_params holds the value of
+    };
+
+    using Keys = std::map<std::string, KeyEntry, std::less<>>;
+
+    struct Record
+    {
+        ParameterSpans spans;  // counted back from the end of the text after the gap
+        bool after_gap;
+        Keys::iterator key;
+        std::size_t edit;  // the edit that parsed the parameter
+    };
+
+    ParameterSpans SpansOf(SpanId id) const;
+    void Flip(SpanId id);
+    void MoveGap(std::size_t offset);
+    void AddSpans(const ParameterSpans& spans, std::vector<Keys::iterator>& touched);
+    void RemoveSpans(SpanId id, std::vector<Keys::iterator>& touched);
+    void ForgetSecondOccurrence(const Occurrences& occurrences);
+    void RememberSecondOccurrence(const Occurrences& occurrences);
+    void UpdateValues(std::vector<Keys::iterator>& touched);
+    void UpdateError();
+
+private:
+    std::string m_text;
+    std::vector<Record> m_records;
+    std::vector<SpanId> m_freeRecords;
+    std::vector<SpanId> m_beforeGap;  // in text order
+    std::vector<SpanId> m_afterGap;   // in reverse text order, so the gap is at the back of both
+    Keys m_keys;
+    // The second occurrence of every repeated key; the first of them is the error ParseParams reports.
+    Occurrences m_secondOccurrences{ByPosition{this}};
+    std::optional<ParsingError> m_syntaxError;  // counted back from the end of the text
+    std::optional<ParsingError> m_error;
+    std::map<std::string, std::string> m_params;
+    std::size_t m_edits = 0;
+    ParamsChunk m_lastReparsed{0, 0};
+};
+
+#endif // INCREMENTAL_PARSER_H_INCLUDED
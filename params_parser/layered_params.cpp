@@ -0,0 +1,105 @@
+#include "layered_params.h"
+
+LayeredParams::LayeredParams(std::vector<Layer> layers)
+    : m_layers(std::move(layers))
+{
+}
+
+void LayeredParams::PushLayer(Layer layer)
+{
+    m_layers.push_back(std::move(layer));
+}
+
+const std::string *LayeredParams::Find(const std::string &key) const
+{
+    for (auto layer = m_layers.rbegin(); layer != m_layers.rend(); ++layer) {
+        const auto found = (*layer)->find(key);
+        if (found != (*layer)->end()) {
+            return &found->second;
+        }
+    }
+    return nullptr;
+}
+
+bool LayeredParams::Contains(const std::string &key) const
+{
+    return Find(key) != nullptr;
+}
+
+LayeredParams::Iterator LayeredParams::begin() const
+{
+    return Iterator(m_layers);
+}
+
+LayeredParams::Iterator LayeredParams::end() const
+{
+    Iterator end;
+    end.m_layers = &m_layers;
+    return end;
+}
+
+LayeredParams::Iterator::Iterator(const std::vector<Layer> &layers)
+    : m_layers(&layers)
+{
+    m_positions.reserve(layers.size());
+    for (const auto &layer : layers) {
+        m_positions.push_back(layer->begin());
+    }
+    FindCurrent();
+}
+
+void LayeredParams::Iterator::FindCurrent()
+{
+    // The smallest key wins; among equal keys the later layer does, hence the `<=`.
+    m_current = m_positions.size();
+    for (std::size_t i = 0; i < m_positions.size(); ++i) {
+        if (m_positions[i] == (*m_layers)[i]->end()) {
+            continue;
+        }
+        if (m_current == m_positions.size() || m_positions[i]->first <= m_positions[m_current]->first) {
+            m_current = i;
+        }
+    }
+    if (m_current == m_positions.size()) {
+        m_positions.clear();
+        m_current = 0;
+    }
+}
+
+LayeredParams::Iterator::reference LayeredParams::Iterator::operator*() const
+{
+    return *m_positions[m_current];
+}
+
+LayeredParams::Iterator::pointer LayeredParams::Iterator::operator->() const
+{
+    return &*m_positions[m_current];
+}
+
+LayeredParams::Iterator &LayeredParams::Iterator::operator++()
+{
+    const auto &key = m_positions[m_current]->first;
+    for (std::size_t i = 0; i < m_positions.size(); ++i) {
+        if (i != m_current && m_positions[i] != (*m_layers)[i]->end() && m_positions[i]->first == key) {
+            ++m_positions[i];
+        }
+    }
+    ++m_positions[m_current];
+    FindCurrent();
+    return *this;
+}
+
+LayeredParams::Iterator LayeredParams::Iterator::operator++(int)
+{
+    auto copy = *this;
+    ++*this;
+    return copy;
+}
+
+bool LayeredParams::Iterator::operator==(const Iterator &other) const
+{
+    if (m_positions.empty() || other.m_positions.empty()) {
+        return m_positions.empty() && other.m_positions.empty();
+    }
+    return m_positions[m_current] == other.m_positions[other.m_current];
+}
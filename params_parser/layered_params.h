@@ -0,0 +1,68 @@
+#ifndef LAYERED_PARAMS_H_INCLUDED
+#define LAYERED_PARAMS_H_INCLUDED
+
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Effective parameters of several parse results stacked on top of each other
+// (e.g. defaults, config file, command line). Lookups and iteration fall through
+// the layers instead of merging them, so the layers can be shared between views.
+class LayeredParams
+{
+public:
+    using Params = std::map<std::string, std::string>;
+    using Layer = std::shared_ptr<const Params>;
+
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Params::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        Iterator() = default;
+
+        reference operator*() const;
+        pointer operator->() const;
+        Iterator& operator++();
+        Iterator operator++(int);
+        bool operator==(const Iterator& other) const;
+
+    private:
+        friend class LayeredParams;
+        explicit Iterator(const std::vector<Layer>& layers);
+        void FindCurrent();
+
+    private:
+        const std::vector<Layer>* m_layers = nullptr;
+        // Position in every layer, all of them past the keys already visited.
+        std::vector<Params::const_iterator> m_positions;
+        // Layer the current entry is taken from, m_positions.size() at the end.
+        std::size_t m_current = 0;
+    };
+
+    // Layers go from the lowest precedence to the highest: a key in a later layer hides it in the earlier ones.
+    explicit LayeredParams(std::vector<Layer> layers = {});
+
+    // Adds a layer that takes precedence over all the current ones.
+    void PushLayer(Layer layer);
+
+    // Value from the layer with the highest precedence that has `key`, nullptr if none has.
+    const std::string* Find(const std::string& key) const;
+    bool Contains(const std::string& key) const;
+
+    // Entries in key order, each key once with its effective value.
+    Iterator begin() const;
+    Iterator end() const;
+
+private:
+    std::vector<Layer> m_layers;
+};
+
+#endif // LAYERED_PARAMS_H_INCLUDED
@@ -1,172 +1,130 @@
 #include "params_parser.h"
 #include "parser_exceptions.h"
-#include "token.h"
+#include "grammar.h"
 
-#include <functional>
+#include <algorithm>
+#include <unordered_set>
 
-namespace parse
-{
-
-struct SingleParameter
-{
-    std::string_view key;
-    std::string value;
-};
-
-void SkipWhitespaces(Source &source)
+std::map<std::string, std::string> ParseParams(const std::string &params)
 {
-    if (source.GetCurrent().token == Token::Whitespaces) {
-        source.Next();
-    }
+    return ParseParams(params, ParseOptions{});
 }
 
-std::string_view Key(Source &source)
+std::map<std::string, std::string> ParseParams(const std::string &params, const ParseOptions &options)
 {
-    const auto slash = source.ExpectOneOf({Token::Slash});
-    const auto key = source.GetCurrent();
-    if (key.token != Token::Word) {
-        throw MissingParameterNameException(
-            source.GetParams(),
-            source.GetBounds(slash.value)
-        );
-    }
-    source.Next();
-    return key.value;
+    return ParseParamsAs<SlashSyntax>(params, options);
 }
 
-std::string ConcatMany(Source &source, const std::unordered_set<Token> &allowed)
+template <typename Syntax>
+std::map<std::string, std::string> ParseParamsAs(std::string_view params, const ParseOptions &options)
 {
-    std::string result;
-    while (source.CheckOneOf(allowed)) {
-        result.append(source.GetCurrent().ToString());
-        source.Next();
+    try {
+        BasicSource<Syntax> source(params, options);
+        std::map<std::string, std::string> result;
+        while (const auto param = parse::NextParam(source)) {
+            auto [_, is_inserted] = result.try_emplace(std::string(param->key), parse::Unescape<Syntax>(param->value));
+            if (!is_inserted) {
+                throw parse::SpecifiedTwice(source, param->key);
+            }
+        }
+        return result;
+    } catch (const ParsingError &error) {
+        ThrowParsingException(params, error);
     }
-    return result;
 }
 
-std::string UnquotedText(Source &source)
+std::map<std::string, std::string> ParseSelectedParams(std::string_view params,
+                                                       const std::vector<std::string_view> &keys,
+                                                       SelectionMode mode,
+                                                       const ParseOptions &options)
 {
-    const auto view = source.GetCurrent();
-    std::string result;
-    switch (view.token) {
-        case Token::EscapedSequence:
-            [[fallthrough]];
-        case Token::Word:
-            return ConcatMany(source, {
-                Token::Word,
-                Token::EscapedSequence,
-                Token::Slash,
-            });
-        case Token::End:
-            [[fallthrough]];
-        case Token::Slash:
-            return "";
-        default:
-            throw std::exception();
+    // Repeated entries in `keys` must not keep StopWhenFound waiting for a parameter that cannot follow.
+    std::size_t wanted = 0;
+    for (auto key = keys.begin(); key != keys.end(); ++key) {
+        wanted += std::find(keys.begin(), key, *key) == key;
     }
-}
-
-std::string QuotedText(Source &source)
-{
-    auto open_quote = source.GetCurrent();
-    source.Next();
-
-    std::string result = ConcatMany(source, {
-        Token::Slash,
-        Token::Word,
-        Token::Whitespaces,
-        Token::Whitespaces,
-        Token::EscapedSequence,
-    });
-
-    switch (source.GetCurrent().token) {
-        case Token::Quote:
-            source.Next();
-            return result;
-        default:
-            throw MissingQuotesException(source.GetParams(), source.ToEnd(open_quote.value));
+    if (mode == SelectionMode::StopWhenFound && wanted == 0) {
+        return {};
+    }
+    try {
+        Source source(params, options);
+        std::map<std::string, std::string> result;
+        // Keys of the skipped parameters are tracked only to report their duplicates.
+        std::unordered_set<std::string_view> skipped;
+        while (const auto param = parse::NextParam(source)) {
+            bool is_unique = true;
+            if (std::ranges::find(keys, param->key) != keys.end()) {
+                is_unique = result.try_emplace(std::string(param->key), parse::Unescape(param->value)).second;
+            } else if (mode == SelectionMode::Strict) {
+                is_unique = skipped.insert(param->key).second;
+            }
+            if (!is_unique) {
+                throw parse::SpecifiedTwice(source, param->key);
+            }
+            if (mode == SelectionMode::StopWhenFound && result.size() == wanted) {
+                break;
+            }
+        }
+        return result;
+    } catch (const ParsingError &error) {
+        ThrowParsingException(params, error);
     }
 }
 
-std::string Value(Source &source)
+std::optional<ParsingError> ValidateParams(std::string_view params, const ParseOptions &options)
 {
-    switch (source.GetCurrent().token) {
-        case Token::Quote:
-            return QuotedText(source);
-        default:
-            return UnquotedText(source);
-    }
+    return ValidateParamsAs<SlashSyntax>(params, options);
 }
 
-SingleParameter Param(Source &source)
+template <typename Syntax>
+std::optional<ParsingError> ValidateParamsAs(std::string_view params, const ParseOptions &options)
 {
-    const auto key = Key(source);
-
-    switch (source.GetCurrent().token) {
-        case Token::End:
-            return SingleParameter{key, ""};
-        case Token::Whitespaces:
-            source.Next();
-            return SingleParameter{key, Value(source)};
-        default:
-            throw UnexpectedValueException(
-                source.GetParams(),
-                source.GetBounds(source.GetCurrent().value)
-            );
+    try {
+        BasicSource<Syntax> source(params, options);
+        std::unordered_set<std::string_view> keys;
+        while (const auto param = parse::NextParam(source)) {
+            if (!keys.insert(param->key).second) {
+                return parse::SpecifiedTwice(source, param->key);
+            }
+        }
+        return std::nullopt;
+    } catch (const ParsingError &error) {
+        return error;
     }
 }
 
-std::map<std::string, std::string> Params(Source &source)
+RecoveredParams ParseParamsRecovering(std::string_view params, const ParseOptions &options)
 {
-    std::map<std::string, std::string> result;
-
+    RecoveredParams result;
+    // Errors are taken from the source instead of being thrown: in this mode there may be one per parameter.
+    Source source(params, options);
     while (true) {
-        SkipWhitespaces(source);
-        switch (source.GetCurrent().token) {
-            case Token::End:
-                return result;
-            case Token::Slash: {
-                const SingleParameter param = Param(source);
-                auto [_, is_inserted] = result.try_emplace(std::string(param.key), std::string(param.value));
-                if (!is_inserted) {
-                    auto bounds =
-                        source.GetBounds(param.key);
-                    bounds.begin--;
-                    throw SpecifiedTwiceParameterException(
-                        source.GetParams(),
-                        bounds
-                    );
-                }
-                break;
+        while (const auto param = parse::TryNextParam(source)) {
+            if (!result.params.try_emplace(std::string(param->key), parse::Unescape(param->value)).second) {
+                result.errors.push_back(parse::SpecifiedTwice(source, param->key));
             }
-            default:
-                const auto begin = source.GetBounds(source.GetCurrent().value).begin;
-                const auto value = Value(source);
-                const auto end = source.GetBounds(source.GetCurrent().value).begin;
-                throw UnexpectedValueException(source.GetParams(),
-                                               {begin, end});
         }
-
-
+        // Restart forgets the error, so it is copied out first.
+        const auto error = source.GetError();
+        if (!error) {
+            return result;
+        }
+        result.errors.push_back(*error);
+        // Limits bound the work per call, so going on past one would defeat them.
+        // This also covers the input size limit, which the source checks on construction.
+        if (error->kind == ParsingErrorKind::LimitExceeded) {
+            return result;
+        }
+        // Every error covers at least one byte, so restarting after it always makes progress.
+        source.Restart(error->position.end);
+        parse::SkipToNextParam(source);
     }
 }
 
-}
-
-std::map<std::string, std::string> ParseParams(const std::string &params)
-{
-    /*
-     * Params -> Param*
-     * Param -> Token::WhiteSpaces? <> Key <> (Token::Whitespaces <> Value)?
-     * Key -> Token::Slash <> Token::Word
-     * Value -> NoQuotedText | QuotedText
-     * NoQuotedText -> ((Token::EscapedSequence | Token::Word) <> (Token::EscapedSequence | Token::Word | Token::Slash)*)?
-     * QuotedText
-     *      -> Token::Quote
-     *      <>  (Token::EscapedSequence | Token::Word | Token::Slash | Token::Whitespaces)*
-     *      <>  Token::Quote
-     */
-    Source source(params);
-    return parse::Params(source);
-}
+template std::map<std::string, std::string> ParseParamsAs<SlashSyntax>(std::string_view, const ParseOptions &);
+template std::map<std::string, std::string> ParseParamsAs<DoubleDashSyntax>(std::string_view, const ParseOptions &);
+template std::map<std::string, std::string> ParseParamsAs<DashColonSyntax>(std::string_view, const ParseOptions &);
 
+template std::optional<ParsingError> ValidateParamsAs<SlashSyntax>(std::string_view, const ParseOptions &);
+template std::optional<ParsingError> ValidateParamsAs<DoubleDashSyntax>(std::string_view, const ParseOptions &);
+template std::optional<ParsingError> ValidateParamsAs<DashColonSyntax>(std::string_view, const ParseOptions &);
@@ -2,9 +2,53 @@
 #define PARAMS_PARSER_H_INCLUDED
 
 #include <string>
+#include <string_view>
 #include <map>
+#include <optional>
+#include <vector>
+
+#include "parse_options.h"
+#include "parser_exceptions.h"
+#include "syntax.h"
 
 std::map<std::string, std::string> ParseParams(const std::string& params);
+std::map<std::string, std::string> ParseParams(const std::string& params, const ParseOptions& options);
 
-#endif // PARAMS_PARSER_H_INCLUDED
+// ParseParams for another syntax policy from syntax.h, e.g. ParseParamsAs<DoubleDashSyntax>("--key=value").
+template <typename Syntax>
+std::map<std::string, std::string> ParseParamsAs(std::string_view params, const ParseOptions& options = {});
+
+enum class SelectionMode
+{
+    // The whole line is checked, errors after the selected parameters are reported too.
+    Strict,
+    // Parsing stops as soon as every selected parameter is found.
+    StopWhenFound,
+};
+
+// Same as ParseParams, but only the parameters listed in `keys` are unescaped and returned.
+// Values of the other parameters are skipped over without being copied.
+std::map<std::string, std::string> ParseSelectedParams(std::string_view params,
+                                                       const std::vector<std::string_view>& keys,
+                                                       SelectionMode mode = SelectionMode::Strict,
+                                                       const ParseOptions& options = {});
+
+// Checks `params` with the same grammar and duplicate rules as ParseParams, without building values.
+// Returns the kind and position of the error ParseParams would throw, or std::nullopt for valid input.
+std::optional<ParsingError> ValidateParams(std::string_view params, const ParseOptions& options = {});
 
+template <typename Syntax>
+std::optional<ParsingError> ValidateParamsAs(std::string_view params, const ParseOptions& options = {});
+
+struct RecoveredParams
+{
+    std::map<std::string, std::string> params;
+    std::vector<ParsingError> errors;
+};
+
+// Parses in a single pass without stopping at errors: each error is recorded and parsing
+// resumes at the next parameter. For a repeated parameter the first value is kept.
+// An exceeded ParseLimits is recorded as the last error, parsing stops there.
+RecoveredParams ParseParamsRecovering(std::string_view params, const ParseOptions& options = {});
+
+#endif // PARAMS_PARSER_H_INCLUDED
@@ -0,0 +1,138 @@
+#include "params_parser_c.h"
+#include "grammar.h"
+
+#include <algorithm>
+#include <string_view>
+
+namespace
+{
+
+pp_status ToStatus(ParsingErrorKind kind)
+{
+    switch (kind) {
+        case ParsingErrorKind::MissingParameterName:
+            return PP_MISSING_PARAMETER_NAME;
+        case ParsingErrorKind::SpecifiedTwiceParameter:
+            return PP_SPECIFIED_TWICE_PARAMETER;
+        case ParsingErrorKind::MissingQuotes:
+            return PP_MISSING_QUOTES;
+        case ParsingErrorKind::LimitExceeded:
+            return PP_LIMIT_EXCEEDED;
+        default:
+            return PP_UNEXPECTED_VALUE;
+    }
+}
+
+std::string_view KeyOf(std::string_view input, const pp_entry &entry)
+{
+    return input.substr(entry.key_offset, entry.key_length);
+}
+
+// Without a hash set, which would allocate, the entries themselves are sorted by key to find
+// the repeated key whose second occurrence comes first, and then put back into input order.
+const pp_entry *FindFirstRepeated(std::string_view input, pp_entry *entries, std::size_t count)
+{
+    std::sort(entries, entries + count, [input](const pp_entry &lhs, const pp_entry &rhs) {
+        const auto lhs_key = KeyOf(input, lhs);
+        const auto rhs_key = KeyOf(input, rhs);
+        return lhs_key != rhs_key ? lhs_key < rhs_key : lhs.key_offset < rhs.key_offset;
+    });
+    std::size_t repeated_at = input.size();
+    for (std::size_t i = 1; i < count; ++i) {
+        const auto key = KeyOf(input, entries[i]);
+        const bool is_second = key == KeyOf(input, entries[i - 1]) && (i == 1 || key != KeyOf(input, entries[i - 2]));
+        if (is_second) {
+            repeated_at = std::min(repeated_at, entries[i].key_offset);
+        }
+    }
+    std::sort(entries, entries + count, [](const pp_entry &lhs, const pp_entry &rhs) {
+        return lhs.key_offset < rhs.key_offset;
+    });
+    const auto repeated = std::find_if(entries, entries + count, [repeated_at](const pp_entry &entry) {
+        return entry.key_offset == repeated_at;
+    });
+    return repeated == entries + count ? nullptr : repeated;
+}
+
+}
+
+pp_status pp_parse(const char *input, size_t input_length, unsigned flags,
+                   pp_entry *entries, size_t entries_capacity,
+                   char *value_buffer, size_t value_buffer_capacity,
+                   pp_result *result)
+{
+    const auto limits = pp_default_limits();
+    return pp_parse_limited(input, input_length, flags, &limits, entries, entries_capacity,
+                            value_buffer, value_buffer_capacity, result);
+}
+
+pp_limits pp_default_limits(void)
+{
+    const ParseLimits limits;
+    return pp_limits{
+        limits.max_input_bytes,
+        limits.max_parameters,
+        limits.max_key_length,
+        limits.max_value_length,
+        limits.max_escape_percent
+    };
+}
+
+pp_status pp_parse_limited(const char *input, size_t input_length, unsigned flags, const pp_limits *limits,
+                           pp_entry *entries, size_t entries_capacity,
+                           char *value_buffer, size_t value_buffer_capacity,
+                           pp_result *result)
+{
+    const std::string_view params(input, input_length);
+    *result = pp_result{};
+    const ParseOptions options{
+        .validate_utf8 = (flags & PP_VALIDATE_UTF8) != 0,
+        .limits = ParseLimits{
+            .max_input_bytes = limits->max_input_bytes,
+            .max_parameters = limits->max_parameters,
+            .max_key_length = limits->max_key_length,
+            .max_value_length = limits->max_value_length,
+            .max_escape_percent = limits->max_escape_percent,
+        },
+    };
+    // TryNextParam reports errors without throwing: an exception object would be allocated.
+    Source source(params, options);
+    bool values_fit = true;
+    while (const auto param = parse::TryNextParam(source)) {
+        const std::span<char> free_space(value_buffer + result->value_buffer_used,
+                                         values_fit ? value_buffer_capacity - result->value_buffer_used : 0);
+        const auto value_length = parse::UnescapeTo(param->value, free_space);
+        result->required_entries++;
+        result->required_value_buffer += value_length;
+        values_fit = values_fit && value_length <= free_space.size();
+        // Entries are kept even when values no longer fit, to look for repeated keys in them.
+        if (result->entry_count == entries_capacity) {
+            continue;
+        }
+        const auto key = source.GetBounds(param->key);
+        entries[result->entry_count++] = pp_entry{
+            key.begin, key.end - key.begin,
+            result->value_buffer_used, value_length
+        };
+        if (values_fit) {
+            result->value_buffer_used += value_length;
+        }
+    }
+
+    // Every parameter precedes a syntax error, so a repeated key is reported first,
+    // but it can only be looked for once all the parameters are in `entries`.
+    if (result->entry_count < result->required_entries) {
+        return PP_BUFFER_TOO_SMALL;
+    }
+    if (const auto repeated = FindFirstRepeated(params, entries, result->entry_count)) {
+        result->error_begin = repeated->key_offset - SlashSyntax::prefix.size();
+        result->error_end = repeated->key_offset + repeated->key_length;
+        return PP_SPECIFIED_TWICE_PARAMETER;
+    }
+    if (const auto &error = source.GetError()) {
+        result->error_begin = error->position.begin;
+        result->error_end = error->position.end;
+        return ToStatus(error->kind);
+    }
+    return values_fit ? PP_OK : PP_BUFFER_TOO_SMALL;
+}
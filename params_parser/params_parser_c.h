@@ -0,0 +1,89 @@
+#ifndef PARAMS_PARSER_C_H_INCLUDED
+#define PARAMS_PARSER_C_H_INCLUDED
+
+/*
+ * C interface to ParseParams for foreign callers.
+ *
+ * The caller owns all memory: keys are reported as offsets into the input,
+ * unescaped values are written to the caller's value buffer, and no call
+ * allocates, not even on errors. When the arrays are too small, the call returns
+ * PP_BUFFER_TOO_SMALL with the capacities it needs in pp_result.
+ */
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum pp_status
+{
+    PP_OK = 0,
+    PP_MISSING_PARAMETER_NAME = 1,
+    PP_UNEXPECTED_VALUE = 2,
+    PP_SPECIFIED_TWICE_PARAMETER = 3,
+    PP_MISSING_QUOTES = 4,
+    PP_BUFFER_TOO_SMALL = 5,
+    PP_LIMIT_EXCEEDED = 6
+} pp_status;
+
+enum
+{
+    PP_VALIDATE_UTF8 = 1
+};
+
+typedef struct pp_entry
+{
+    size_t key_offset;    /* in the input */
+    size_t key_length;
+    size_t value_offset;  /* in the value buffer */
+    size_t value_length;
+} pp_entry;
+
+/* Same meaning as ParseLimits; pp_default_limits() leaves everything unlimited. */
+typedef struct pp_limits
+{
+    size_t max_input_bytes;
+    size_t max_parameters;
+    size_t max_key_length;
+    size_t max_value_length;
+    size_t max_escape_percent;
+} pp_limits;
+
+typedef struct pp_result
+{
+    size_t entry_count;
+    size_t value_buffer_used;
+    /* Capacities needed for the input up to its first syntax error, valid with PP_OK and PP_BUFFER_TOO_SMALL. */
+    size_t required_entries;
+    size_t required_value_buffer;
+    /* Erroneous part of the input as [error_begin, error_end), like ParamsChunk. */
+    size_t error_begin;
+    size_t error_end;
+} pp_result;
+
+/*
+ * Parses `input_length` bytes of `input`. `flags` is 0 or PP_VALIDATE_UTF8.
+ * Once `entries` holds every parameter, the status is the error ParseParams would throw,
+ * or PP_BUFFER_TOO_SMALL if only the values do not fit. Before that the call returns
+ * PP_BUFFER_TOO_SMALL even for malformed input, as a repeated parameter may precede the
+ * syntax error. Repeated parameters are found by sorting `entries` in O(n log n).
+ */
+pp_status pp_parse(const char* input, size_t input_length, unsigned flags,
+                   pp_entry* entries, size_t entries_capacity,
+                   char* value_buffer, size_t value_buffer_capacity,
+                   pp_result* result);
+
+pp_limits pp_default_limits(void);
+
+/* pp_parse for untrusted input: exceeding `limits` returns PP_LIMIT_EXCEEDED. */
+pp_status pp_parse_limited(const char* input, size_t input_length, unsigned flags, const pp_limits* limits,
+                           pp_entry* entries, size_t entries_capacity,
+                           char* value_buffer, size_t value_buffer_capacity,
+                           pp_result* result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PARAMS_PARSER_C_H_INCLUDED */
@@ -0,0 +1,31 @@
+#ifndef PARSE_OPTIONS_H_INCLUDED
+#define PARSE_OPTIONS_H_INCLUDED
+
+#include <cstddef>
+#include <limits>
+
+// Bounds on the work done for untrusted input. Exceeding any of them raises
+// LimitExceededException positioned on the offending part of the input.
+struct ParseLimits
+{
+    static constexpr std::size_t UNLIMITED = std::numeric_limits<std::size_t>::max();
+
+    std::size_t max_input_bytes = UNLIMITED;
+    std::size_t max_parameters = UNLIMITED;
+    std::size_t max_key_length = UNLIMITED;
+    // Length of a value as written, including quotes and escape characters.
+    std::size_t max_value_length = UNLIMITED;
+    // Share of a value's bytes taken by escaped sequences, in percent.
+    std::size_t max_escape_percent = 100;
+};
+
+struct ParseOptions
+{
+    // Reject input that is not well-formed UTF-8 with UnexpectedValueException
+    // positioned on the offending bytes. Checked while tokenizing, no separate pass.
+    bool validate_utf8 = false;
+
+    ParseLimits limits;
+};
+
+#endif // PARSE_OPTIONS_H_INCLUDED
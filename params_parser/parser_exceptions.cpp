@@ -2,13 +2,20 @@
 
 using namespace std;
 
-ParsingException::ParsingException(const string& description, std::string_view params, const ParamsChunk& position) :
+ParsingException::ParsingException(ParsingErrorKind kind, const string& description, std::string_view params,
+                                   const ParamsChunk& position) :
+    m_kind(kind),
     m_description(FormatFullDescription(description, params, position)),
     m_params(params),
     m_errorPos(position)
 {
 }
 
+ParsingErrorKind ParsingException::GetErrorKind() const
+{
+    return m_kind;
+}
+
 ParamsChunk ParsingException::GetErrorPosition() const
 {
     return m_errorPos;
@@ -27,22 +34,27 @@ string ParsingException::FormatFullDescription(const string& description, std::s
 }
 
 MissingParameterNameException::MissingParameterNameException(std::string_view params, const ParamsChunk& position) :
-    ParsingException("Parameter name is missing", params, position)
+    ParsingException(ParsingErrorKind::MissingParameterName, "Parameter name is missing", params, position)
 {
 }
 
 UnexpectedValueException::UnexpectedValueException(std::string_view params, const ParamsChunk& position) :
-    ParsingException("Unexpected value", params, position)
+    ParsingException(ParsingErrorKind::UnexpectedValue, "Unexpected value", params, position)
 {
 }
 
 SpecifiedTwiceParameterException::SpecifiedTwiceParameterException(std::string_view params, const ParamsChunk& position) :
-    ParsingException("Parameter is specified twice", params, position)
+    ParsingException(ParsingErrorKind::SpecifiedTwiceParameter, "Parameter is specified twice", params, position)
 {
 }
 
 MissingQuotesException::MissingQuotesException(std::string_view params, const ParamsChunk& position) :
-    ParsingException("Missing terminating quotes character", params, position)
+    ParsingException(ParsingErrorKind::MissingQuotes, "Missing terminating quotes character", params, position)
+{
+}
+
+LimitExceededException::LimitExceededException(std::string_view params, const ParamsChunk& position) :
+    ParsingException(ParsingErrorKind::LimitExceeded, "Parsing limit exceeded", params, position)
 {
 }
 
@@ -51,3 +63,20 @@ const char* ParsingException::what() const noexcept
     return m_description.c_str();
 }
 
+void ThrowParsingException(std::string_view params, const ParsingError& error)
+{
+    switch (error.kind)
+    {
+        case ParsingErrorKind::MissingParameterName:
+            throw MissingParameterNameException(params, error.position);
+        case ParsingErrorKind::UnexpectedValue:
+            throw UnexpectedValueException(params, error.position);
+        case ParsingErrorKind::SpecifiedTwiceParameter:
+            throw SpecifiedTwiceParameterException(params, error.position);
+        case ParsingErrorKind::MissingQuotes:
+            throw MissingQuotesException(params, error.position);
+        case ParsingErrorKind::LimitExceeded:
+            throw LimitExceededException(params, error.position);
+    }
+    throw UnexpectedValueException(params, error.position);
+}
@@ -9,13 +9,31 @@ struct ParamsChunk
     size_t end;
 };
 
+enum class ParsingErrorKind
+{
+    MissingParameterName,
+    UnexpectedValue,
+    SpecifiedTwiceParameter,
+    MissingQuotes,
+    LimitExceeded,
+};
+
+// What a ParsingException carries, without the formatted description and the copy of the input.
+struct ParsingError
+{
+    ParsingErrorKind kind;
+    ParamsChunk position;
+};
+
 class ParsingException : public std::exception
 {
 public:
-    ParsingException(const std::string& description, std::string_view params, const ParamsChunk& position);
+    ParsingException(ParsingErrorKind kind, const std::string& description, std::string_view params,
+                     const ParamsChunk& position);
     virtual ~ParsingException() = default;
 
     const char* what() const noexcept override;
+    ParsingErrorKind GetErrorKind() const;
     ParamsChunk GetErrorPosition() const;
     std::string GetErrorPart() const;
 
@@ -24,6 +42,7 @@ private:
                                              const ParamsChunk& position);
 
 private:
+    const ParsingErrorKind m_kind;
     const std::string m_description;
     const std::string m_params;
     const ParamsChunk m_errorPos;
@@ -53,5 +72,14 @@ public:
     MissingQuotesException(std::string_view params, const ParamsChunk& position);
 };
 
+class LimitExceededException : public ParsingException
+{
+public:
+    LimitExceededException(std::string_view params, const ParamsChunk& position);
+};
+
+// Throws the ParsingException subclass matching `error.kind`.
+[[noreturn]] void ThrowParsingException(std::string_view params, const ParsingError& error);
+
 #endif // PARSER_EXCEPTIONS_H_INCLUDED
 
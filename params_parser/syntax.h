@@ -0,0 +1,49 @@
+#ifndef PARAMS_SYNTAX_H_INCLUDED
+#define PARAMS_SYNTAX_H_INCLUDED
+
+#include <string_view>
+
+/*
+ * Syntax policies the lexer and the grammar are instantiated with.
+ *
+ * prefix     starts every parameter name
+ * separator  goes between a name and its value, ' ' stands for any run of whitespace;
+ *            with any other separator whitespace right after the name means an empty value
+ * quote      encloses values with whitespace
+ * escape     makes the next escape, quote, prefix or space character a part of the value
+ *
+ * A new policy needs explicit instantiations next to the existing ones in
+ * token.cpp, grammar.cpp and params_parser.cpp.
+ */
+
+// /key value
+struct SlashSyntax
+{
+    static constexpr std::string_view prefix = "/";
+    static constexpr char separator = ' ';
+    static constexpr char quote = '"';
+    static constexpr char escape = '\\';
+};
+
+// --key=value
+struct DoubleDashSyntax
+{
+    static constexpr std::string_view prefix = "--";
+    static constexpr char separator = '=';
+    static constexpr char quote = '"';
+    static constexpr char escape = '\\';
+};
+
+// -key:value
+struct DashColonSyntax
+{
+    static constexpr std::string_view prefix = "-";
+    static constexpr char separator = ':';
+    static constexpr char quote = '"';
+    static constexpr char escape = '\\';
+};
+
+template <typename Syntax>
+constexpr bool IS_SEPARATED_BY_WHITESPACE = Syntax::separator == ' ';
+
+#endif // PARAMS_SYNTAX_H_INCLUDED
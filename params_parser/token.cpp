@@ -2,135 +2,346 @@
 #include "parser_exceptions.h"
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
 #include <string>
 
 namespace
 {
 
-const std::unordered_map<std::string, Token> FIXED_SIZE_TOKENS = {
-    {"/", Token::Slash},
-    {"\\\\", Token::EscapedSequence},
-    {"\\\"", Token::EscapedSequence},
-    {"\\/", Token::EscapedSequence},
-    {"\\ ", Token::EscapedSequence},
-    {"\"", Token::Quote},
+enum class CharClass : unsigned char
+{
+    Other,
+    Whitespace,
+    PrefixStart,
+    Separator,
+    Quote,
+    Escape,
+    NonAscii,
 };
 
-std::optional<View> ReadFixedSize(std::string_view from)
-{
-    for (const auto &[view, token] : FIXED_SIZE_TOKENS) {
-        if (from.starts_with(view)) {
-            return View{token, from.substr(0, view.size())};
-        }
+// Fixed "C" locale classification, so the lexer does not depend on the global locale
+// and bytes of multibyte UTF-8 characters are never passed to <cctype>.
+template <typename Syntax>
+constexpr auto CHAR_CLASSES = [] {
+    std::array<CharClass, 256> classes{};
+    for (const unsigned char c : {' ', '\t', '\n', '\v', '\f', '\r'}) {
+        classes[c] = CharClass::Whitespace;
+    }
+    if constexpr (!IS_SEPARATED_BY_WHITESPACE<Syntax>) {
+        classes[static_cast<unsigned char>(Syntax::separator)] = CharClass::Separator;
     }
-    return std::nullopt;
+    classes[static_cast<unsigned char>(Syntax::prefix.front())] = CharClass::PrefixStart;
+    classes[static_cast<unsigned char>(Syntax::quote)] = CharClass::Quote;
+    classes[static_cast<unsigned char>(Syntax::escape)] = CharClass::Escape;
+    for (std::size_t c = 0x80; c < classes.size(); ++c) {
+        classes[c] = CharClass::NonAscii;
+    }
+    return classes;
+}();
+
+template <typename Syntax>
+CharClass Classify(char c)
+{
+    return CHAR_CLASSES<Syntax>[static_cast<unsigned char>(c)];
 }
 
-std::optional<View> ReadEnd(std::string_view from)
+template <typename Syntax>
+bool IsEscapable(char c)
 {
-    if (from.empty()) {
-        return View{Token::End, from};
-    }
-    return std::nullopt;
+    return c == Syntax::escape || c == Syntax::quote || c == Syntax::prefix.front() || c == ' ';
 }
 
-std::optional<View> ReadUntil(std::string_view from, Token token, const std::function<bool(char)> &predicate)
+template <typename Syntax>
+bool IsEscapedSequence(std::string_view from)
 {
-    auto slice =
-        std::string_view(from.begin(), std::ranges::find_if_not(from, predicate));
-    if (slice.empty()) {
-        return std::nullopt;
-    }
-    return View{token, slice};
+    return from.size() >= 2 && from[0] == Syntax::escape && IsEscapable<Syntax>(from[1]);
 }
 
-std::optional<View> ReadWhitespaces(std::string_view from)
+// Length of the leading run of plain ASCII word bytes, eight bytes at a time.
+template <typename Syntax>
+std::size_t SkipAsciiWordBytes(std::string_view from)
 {
-    return ReadUntil(from, Token::Whitespaces, static_cast<int (*)(int)>(&std::isspace));
+    constexpr std::uint64_t ONES = 0x0101010101010101;
+    constexpr std::uint64_t HIGH_BITS = 0x8080808080808080;
+    const auto has_byte = [](std::uint64_t word, char c) {
+        const std::uint64_t diff = word ^ (ONES * static_cast<unsigned char>(c));
+        return ((diff - ONES) & ~diff & HIGH_BITS) != 0;
+    };
+
+    std::size_t length = 0;
+    while (from.size() - length >= sizeof(std::uint64_t)) {
+        std::uint64_t word;
+        std::memcpy(&word, from.data() + length, sizeof(word));
+        // Bytes below '!' cover all whitespace; the few other control characters just take the slow path.
+        bool has_special = ((word - ONES * '!') & ~word & HIGH_BITS) != 0 ||
+                           (word & HIGH_BITS) != 0 ||
+                           has_byte(word, Syntax::prefix.front()) ||
+                           has_byte(word, Syntax::quote) ||
+                           has_byte(word, Syntax::escape);
+        if constexpr (!IS_SEPARATED_BY_WHITESPACE<Syntax>) {
+            has_special = has_special || has_byte(word, Syntax::separator);
+        }
+        if (has_special) {
+            break;
+        }
+        length += sizeof(word);
+    }
+    return length;
 }
 
-std::optional<View> ReadWord(std::string_view from)
+// Length of the valid UTF-8 sequence starting at `from`, or 0 with `invalid` set to the offending bytes.
+std::size_t ReadUtf8Sequence(std::string_view from, std::string_view &invalid)
 {
-    std::size_t word_length = 0;
-    while (true) {
-        std::string_view after = from.substr(word_length, from.length() - word_length);
-        if (ReadEnd(after) || ReadFixedSize(after) || ReadWhitespaces(after)) {
-            return View{Token::Word, from.substr(0, word_length)};
+    const auto lead = static_cast<unsigned char>(from[0]);
+    std::size_t length = 0;
+    unsigned char min_second = 0x80;
+    unsigned char max_second = 0xBF;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        min_second = lead == 0xE0 ? 0xA0 : 0x80;  // overlong
+        max_second = lead == 0xED ? 0x9F : 0xBF;  // surrogates
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        min_second = lead == 0xF0 ? 0x90 : 0x80;  // overlong
+        max_second = lead == 0xF4 ? 0x8F : 0xBF;  // above U+10FFFF
+    } else {
+        invalid = from.substr(0, 1);
+        return 0;
+    }
+
+    for (std::size_t i = 1; i < length; ++i) {
+        const auto byte = i < from.size() ? static_cast<unsigned char>(from[i]) : 0;
+        const auto min = i == 1 ? min_second : 0x80;
+        const auto max = i == 1 ? max_second : 0xBF;
+        if (byte < min || byte > max) {
+            invalid = from.substr(0, i);
+            return 0;
         }
+    }
+    return length;
+}
 
-        word_length++;
+template <typename Syntax>
+std::optional<View> ReadWord(std::string_view from, bool validate_utf8, std::string_view &invalid)
+{
+    std::size_t length = 0;
+    while (length < from.size()) {
+        length += SkipAsciiWordBytes<Syntax>(from.substr(length));
+        if (length == from.size()) {
+            break;
+        }
+        const auto rest = from.substr(length);
+        switch (Classify<Syntax>(rest.front())) {
+            case CharClass::Other:
+                length++;
+                continue;
+            case CharClass::PrefixStart:
+                if (rest.starts_with(Syntax::prefix)) {
+                    break;
+                }
+                length++;
+                continue;
+            case CharClass::Escape:
+                if (IsEscapedSequence<Syntax>(rest)) {
+                    break;
+                }
+                length++;
+                continue;
+            case CharClass::NonAscii:
+                if (!validate_utf8) {
+                    length++;
+                    continue;
+                }
+                if (const auto sequence = ReadUtf8Sequence(rest, invalid)) {
+                    length += sequence;
+                    continue;
+                }
+                return std::nullopt;
+            default:
+                break;
+        }
+        break;
     }
+    return View{Token::Word, from.substr(0, length)};
 }
 
-std::optional<View> ReadTokenFrom(std::string_view source)
+template <typename Syntax>
+std::optional<View> ReadWhitespaces(std::string_view from)
 {
-    if (const auto end = ReadEnd(source)) return end;
-    if (const auto fixed_size = ReadFixedSize(source)) return fixed_size;
-    if (const auto whitespaces = ReadWhitespaces(source)) return whitespaces;
-    if (const auto word = ReadWord(source)) return word;
+    const auto end = std::ranges::find_if(from, [](char c) {
+        return Classify<Syntax>(c) != CharClass::Whitespace;
+    });
+    return View{Token::Whitespaces, std::string_view(from.begin(), end)};
+}
 
-    return std::nullopt;
+template <typename Syntax>
+std::optional<View> ReadTokenFrom(std::string_view source, bool validate_utf8, std::string_view &invalid)
+{
+    if (source.empty()) {
+        return View{Token::End, source};
+    }
+    switch (Classify<Syntax>(source.front())) {
+        case CharClass::PrefixStart:
+            if (source.starts_with(Syntax::prefix)) {
+                return View{Token::Prefix, source.substr(0, Syntax::prefix.size())};
+            }
+            break;
+        case CharClass::Separator:
+            return View{Token::Separator, source.substr(0, 1)};
+        case CharClass::Quote:
+            return View{Token::Quote, source.substr(0, 1)};
+        case CharClass::Whitespace:
+            return ReadWhitespaces<Syntax>(source);
+        case CharClass::Escape:
+            if (IsEscapedSequence<Syntax>(source)) {
+                return View{Token::EscapedSequence, source.substr(0, 2)};
+            }
+            break;
+        default:
+            break;
+    }
+    return ReadWord<Syntax>(source, validate_utf8, invalid);
 }
 
 }
 
-ParamsChunk Source::GetBounds(std::string_view sub_view) const
+template <typename Syntax>
+ParamsChunk BasicSource<Syntax>::GetBounds(std::string_view sub_view) const
 {
     const std::size_t begin = std::distance(m_params.data(), sub_view.data());
     return ParamsChunk{begin, begin + sub_view.size()};
 }
 
-void Source::Next()
+template <typename Syntax>
+void BasicSource<Syntax>::Next()
 {
-    const auto view = ReadTokenFrom(m_rest);
+    std::string_view invalid = m_rest;
+    const auto view = ReadTokenFrom<Syntax>(m_rest, m_options.validate_utf8, invalid);
     if (!view.has_value()) {
-        throw UnexpectedValueException(m_params, GetBounds(m_rest));
+        Fail(ParsingError{ParsingErrorKind::UnexpectedValue, GetBounds(invalid)});
+        return;
     }
     m_current = view.value();
+    if (m_current.token == Token::EscapedSequence) {
+        m_escapedCount++;
+    }
     m_rest = std::string_view(std::next(m_rest.begin(), m_current.value.size()), m_rest.end());
 }
 
-View Source::GetCurrent() const
+template <typename Syntax>
+void BasicSource<Syntax>::Restart(std::size_t offset)
+{
+    m_error.reset();
+    m_rest = m_params.substr(offset);
+    Next();
+}
+
+template <typename Syntax>
+void BasicSource<Syntax>::Fail(const ParsingError &error)
+{
+    if (!m_error) {
+        m_error = error;
+    }
+    m_rest = m_params.substr(m_params.size());
+    m_current = View{Token::End, m_rest};
+}
+
+template <typename Syntax>
+const std::optional<ParsingError> &BasicSource<Syntax>::GetError() const
+{
+    return m_error;
+}
+
+template <typename Syntax>
+View BasicSource<Syntax>::GetCurrent() const
 {
     return m_current;
 }
 
-Source::Source(std::string_view params)
-    : m_rest(params), m_params(params)
+template <typename Syntax>
+BasicSource<Syntax>::BasicSource(std::string_view params, const ParseOptions &options)
+    : BasicSource(params, 0, options)
 {
+}
+
+template <typename Syntax>
+BasicSource<Syntax>::BasicSource(std::string_view params, std::size_t offset, const ParseOptions &options)
+    : m_rest(params.substr(offset)), m_params(params), m_options(options)
+{
+    if (params.size() > m_options.limits.max_input_bytes) {
+        Fail(ParsingError{ParsingErrorKind::LimitExceeded, {m_options.limits.max_input_bytes, params.size()}});
+        return;
+    }
     Next();
 }
 
-View Source::ExpectOneOf(const std::unordered_set<Token> &tokens)
+template <typename Syntax>
+View BasicSource<Syntax>::ExpectOneOf(std::initializer_list<Token> tokens)
 {
     if (!CheckOneOf(tokens)) {
-        throw UnexpectedValueException(m_params, GetBounds(m_current.value));
+        Fail(ParsingError{ParsingErrorKind::UnexpectedValue, GetBounds(m_current.value)});
+        return m_current;
     }
     const auto current = GetCurrent();
     Next();
     return current;
 }
 
-std::string_view Source::GetParams() const
+template <typename Syntax>
+std::string_view BasicSource<Syntax>::GetParams() const
 {
     return m_params;
 }
 
-bool Source::CheckOneOf(const std::unordered_set<Token> &tokens) const
+template <typename Syntax>
+bool BasicSource<Syntax>::CheckOneOf(std::initializer_list<Token> tokens) const
 {
-    return tokens.contains(GetCurrent().token);
+    return std::ranges::find(tokens, GetCurrent().token) != tokens.end();
 }
 
-ParamsChunk Source::ToEnd(std::string_view from) const
+template <typename Syntax>
+std::string_view BasicSource<Syntax>::Since(std::string_view from) const
+{
+    return std::string_view(from.data(), std::distance(from.data(), m_current.value.data()));
+}
+
+template <typename Syntax>
+ParamsChunk BasicSource<Syntax>::ToEnd(std::string_view from) const
 {
     auto bounds = GetBounds(from);
     return {bounds.begin, m_params.size()};
 }
 
-std::string View::ToString() const
+template <typename Syntax>
+const ParseOptions &BasicSource<Syntax>::GetOptions() const
+{
+    return m_options;
+}
+
+template <typename Syntax>
+std::size_t BasicSource<Syntax>::GetEscapedCount() const
+{
+    return m_escapedCount;
+}
+
+template <typename Syntax>
+std::size_t BasicSource<Syntax>::CountParameter()
+{
+    return ++m_parameterCount;
+}
+
+std::string_view View::Unescaped() const
 {
     if (token == Token::EscapedSequence) {
-        return std::string{std::next(value.begin()), value.end()};
+        return value.substr(1);
     }
-    return std::string(value);
+    return value;
 }
+
+template struct BasicSource<SlashSyntax>;
+template struct BasicSource<DoubleDashSyntax>;
+template struct BasicSource<DashColonSyntax>;
@@ -4,14 +4,17 @@
 #include <string_view>
 #include <string>
 #include <optional>
-#include <unordered_set>
+#include <initializer_list>
 
+#include "parse_options.h"
 #include "parser_exceptions.h"
+#include "syntax.h"
 
 enum class Token
 {
     Quote,
-    Slash,
+    Prefix,
+    Separator,
     EscapedSequence,
     Word,
     Whitespaces,
@@ -23,10 +26,12 @@ struct View
     Token token;
     std::string_view value;
 
-    [[nodiscard]] std::string ToString() const;
+    // Token text with the escape character dropped from escaped sequences.
+    [[nodiscard]] std::string_view Unescaped() const;
 };
 
-struct Source
+template <typename Syntax>
+struct BasicSource
 {
     [[nodiscard]] View GetCurrent() const;
 
@@ -34,21 +39,51 @@ struct Source
 
     void Next();
 
-    explicit Source(std::string_view params);
+    // Continues reading from `offset` of the whole params, forgetting an earlier error.
+    void Restart(std::size_t offset);
 
-    [[nodiscard]] bool CheckOneOf(const std::unordered_set<Token> &tokens) const;
+    // Records `error` unless an earlier one is recorded already and moves to the end of input,
+    // so that the grammar unwinds without exceptions.
+    void Fail(const ParsingError &error);
 
-    View ExpectOneOf(const std::unordered_set<Token> &tokens);
+    // The first error met by the source or the grammar, if any.
+    [[nodiscard]] const std::optional<ParsingError> &GetError() const;
+
+    explicit BasicSource(std::string_view params, const ParseOptions &options = {});
+
+    // Starts reading at `offset`; positions are still reported relative to the whole `params`.
+    BasicSource(std::string_view params, std::size_t offset, const ParseOptions &options = {});
+
+    [[nodiscard]] bool CheckOneOf(std::initializer_list<Token> tokens) const;
+
+    View ExpectOneOf(std::initializer_list<Token> tokens);
 
     [[nodiscard]] ParamsChunk ToEnd(std::string_view from) const;
 
     ParamsChunk GetBounds(std::string_view sub_view) const;
 
+    // Text from the beginning of `from` up to the current token.
+    [[nodiscard]] std::string_view Since(std::string_view from) const;
+
+    [[nodiscard]] const ParseOptions &GetOptions() const;
+
+    // Escaped sequences read so far, for ParseLimits::max_escape_percent.
+    [[nodiscard]] std::size_t GetEscapedCount() const;
+
+    // Registers one more parameter and returns how many there are, for ParseLimits::max_parameters.
+    std::size_t CountParameter();
+
 private:
     View m_current;
     std::string_view m_rest;
     std::string_view m_params;
+    ParseOptions m_options;
+    std::size_t m_escapedCount = 0;
+    std::size_t m_parameterCount = 0;
+    std::optional<ParsingError> m_error;
 };
 
+using Source = BasicSource<SlashSyntax>;
+
 
 #endif //PARSERPROJECT_TOKENIZER_H
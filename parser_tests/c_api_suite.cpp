@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include <params_parser/params_parser.h>
+#include <params_parser/params_parser_c.h>
+
+#include <cstdlib>
+#include <new>
+
+using namespace std;
+
+namespace
+{
+    bool g_countAllocations = false;
+    size_t g_allocations = 0;
+
+    map<string, string> ToMap(const string& input, const vector<pp_entry>& entries, const pp_result& result,
+                              const string& buffer)
+    {
+        map<string, string> params;
+        for (size_t i = 0; i < result.entry_count; ++i)
+        {
+            params.emplace(input.substr(entries[i].key_offset, entries[i].key_length),
+                           buffer.substr(entries[i].value_offset, entries[i].value_length));
+        }
+        return params;
+    }
+}
+
+void* operator new(size_t size)
+{
+    if (g_countAllocations)
+    {
+        g_allocations++;
+    }
+    if (void* memory = malloc(size == 0 ? 1 : size))
+    {
+        return memory;
+    }
+    throw bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    free(memory);
+}
+
+TEST(CApiSuite, ParseTest)
+{
+    const map<string, string> EXPECTED = {
+        { "silent", "" },
+        { "name", "Jane Doe" },
+        { "path", "/home/user dir" }
+    };
+    const auto INPUT = "/silent /name \"Jane Doe\" /path \\/home/user\\ dir"s;
+    vector<pp_entry> entries(8);
+    string buffer(64, '\0');
+    pp_result result;
+
+    g_countAllocations = true;
+    const auto status = pp_parse(INPUT.data(), INPUT.size(), 0, entries.data(), entries.size(),
+                                 buffer.data(), buffer.size(), &result);
+    g_countAllocations = false;
+
+    ASSERT_EQ(PP_OK, status);
+    ASSERT_EQ(0, g_allocations);
+    ASSERT_EQ(3, result.entry_count);
+    ASSERT_EQ(3, result.required_entries);
+    ASSERT_EQ(22, result.value_buffer_used);
+    ASSERT_EQ(22, result.required_value_buffer);
+    ASSERT_EQ(EXPECTED, ToMap(INPUT, entries, result, buffer));
+}
+
+TEST(CApiSuite, BufferTooSmallTest)
+{
+    const auto INPUT = "/a 123 /b \"4 5\" /c 6"s;
+    vector<pp_entry> entries(1);
+    string buffer(16, '\0');
+    pp_result result;
+
+    ASSERT_EQ(PP_BUFFER_TOO_SMALL, pp_parse(INPUT.data(), INPUT.size(), 0, entries.data(), entries.size(),
+                                            buffer.data(), buffer.size(), &result));
+    ASSERT_EQ(1, result.entry_count);
+    ASSERT_EQ(3, result.required_entries);
+    ASSERT_EQ(7, result.required_value_buffer);
+
+    ASSERT_EQ(PP_BUFFER_TOO_SMALL, pp_parse(INPUT.data(), INPUT.size(), 0, nullptr, 0, nullptr, 0, &result));
+    ASSERT_EQ(0, result.entry_count);
+    ASSERT_EQ(3, result.required_entries);
+    ASSERT_EQ(7, result.required_value_buffer);
+
+    entries.resize(result.required_entries);
+    buffer.resize(result.required_value_buffer);
+    ASSERT_EQ(PP_OK, pp_parse(INPUT.data(), INPUT.size(), 0, entries.data(), entries.size(),
+                              buffer.data(), buffer.size(), &result));
+    ASSERT_EQ("1234 56", buffer);
+}
+
+TEST(CApiSuite, ErrorsTest)
+{
+    const vector<tuple<string, pp_status, size_t, size_t>> CASES = {
+        { "/first 1 / 2", PP_MISSING_PARAMETER_NAME, 9, 10 },
+        { "/verbosity quiet something else", PP_UNEXPECTED_VALUE, 17, 26 },
+        { "/verbosity debug /verbosity quiet", PP_SPECIFIED_TWICE_PARAMETER, 17, 27 },
+        { "/name \"Jane Doe", PP_MISSING_QUOTES, 6, 15 },
+        { "/a \xe2\x82", PP_UNEXPECTED_VALUE, 3, 5 },
+    };
+    vector<pp_entry> entries(8);
+    string buffer(64, '\0');
+    for (const auto& [input, status, begin, end] : CASES)
+    {
+        pp_result result;
+        g_allocations = 0;
+        g_countAllocations = true;
+        const auto actual = pp_parse(input.data(), input.size(), PP_VALIDATE_UTF8, entries.data(), entries.size(),
+                                     buffer.data(), buffer.size(), &result);
+        g_countAllocations = false;
+        ASSERT_EQ(status, actual) << input;
+        ASSERT_EQ(0, g_allocations) << input;
+        ASSERT_EQ(begin, result.error_begin) << input;
+        ASSERT_EQ(end, result.error_end) << input;
+    }
+}
+
+TEST(CApiSuite, RepeatedBeforeSyntaxErrorTest)
+{
+    const auto INPUT = "/x ya\t/x y=\""s;
+    pp_result result;
+    ASSERT_EQ(PP_BUFFER_TOO_SMALL, pp_parse(INPUT.data(), INPUT.size(), 0, nullptr, 0, nullptr, 0, &result));
+    ASSERT_EQ(2, result.required_entries);
+
+    vector<pp_entry> entries(result.required_entries);
+    ASSERT_EQ(PP_SPECIFIED_TWICE_PARAMETER, pp_parse(INPUT.data(), INPUT.size(), 0, entries.data(), entries.size(),
+                                                     nullptr, 0, &result));
+    ASSERT_EQ(6, result.error_begin);
+    ASSERT_EQ(8, result.error_end);
+
+    string buffer(64, '\0');
+    ASSERT_EQ(PP_SPECIFIED_TWICE_PARAMETER, pp_parse(INPUT.data(), INPUT.size(), 0, entries.data(), entries.size(),
+                                                     buffer.data(), buffer.size(), &result));
+    ASSERT_EQ(6, result.error_begin);
+    ASSERT_EQ(8, result.error_end);
+}
+
+TEST(CApiSuite, ManyParametersTest)
+{
+    string input;
+    for (int i = 0; i < 40000; ++i)
+    {
+        input += "/key" + to_string(39999 - i) + " " + to_string(i) + " ";
+    }
+    vector<pp_entry> entries(40002);
+    string buffer(input.size(), '\0');
+    pp_result result;
+    ASSERT_EQ(PP_OK, pp_parse(input.data(), input.size(), 0, entries.data(), entries.size(),
+                              buffer.data(), buffer.size(), &result));
+    ASSERT_EQ(40000, result.entry_count);
+    ASSERT_EQ("key39999", input.substr(entries[0].key_offset, entries[0].key_length));
+    ASSERT_EQ("39999", buffer.substr(entries[39999].value_offset, entries[39999].value_length));
+
+    const auto repeated = input + "/key20000 again /key5 again";
+    const auto expected = ValidateParams(repeated);
+    ASSERT_EQ(PP_SPECIFIED_TWICE_PARAMETER, pp_parse(repeated.data(), repeated.size(), 0, entries.data(),
+                                                     entries.size(), buffer.data(), 0, &result));
+    ASSERT_EQ(expected->position.begin, result.error_begin);
+    ASSERT_EQ(expected->position.end, result.error_end);
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <params_parser/params_parser.h>
+#include <params_parser/parser_exceptions.h>
+
+using namespace std;
+
+namespace
+{
+    const ParseOptions VALIDATE_UTF8 = {.validate_utf8 = true, .limits = {}};
+}
+
+TEST(EncodingSuite, AllWhitespacesTest)
+{
+    const map<string, string> EXPECTED = {
+        { "a", "1" },
+        { "b", "2" }
+    };
+    ASSERT_EQ(EXPECTED, ParseParams("\r\n/a\v1\f/b\t2\n"));
+}
+
+TEST(EncodingSuite, LongWordsTest)
+{
+    const map<string, string> EXPECTED = {
+        { "long_parameter_name", "abcdefghijklmnopqrstuvwxyz/0123456789\\x" },
+        { "q", "quoted value with \"quotes\" and \\/slashes/" }
+    };
+    const auto result = ParseParams(
+        "/long_parameter_name abcdefghijklmnopqrstuvwxyz/0123456789\\x "
+        "/q \"quoted value with \\\"quotes\\\" and \\\\/slashes\\/\""
+    );
+    ASSERT_EQ(EXPECTED, result);
+}
+
+TEST(EncodingSuite, NonAsciiWithoutValidationTest)
+{
+    const map<string, string> EXPECTED = {
+        { "имя", "значение" },
+        { "raw", "\xff\xfe" }
+    };
+    ASSERT_EQ(EXPECTED, ParseParams("/имя значение /raw \xff\xfe"));
+}
+
+TEST(EncodingSuite, ValidUtf8Test)
+{
+    const map<string, string> EXPECTED = {
+        { "имя", "Jane Doe 😀" },
+        { "path", "C:\\Users\\日本\\€" }
+    };
+    ASSERT_EQ(EXPECTED, ParseParams("/имя \"Jane Doe 😀\" /path C:\\Users\\日本\\€", VALIDATE_UTF8));
+}
+
+TEST(EncodingSuite, InvalidUtf8PositionsTest)
+{
+    const vector<tuple<string, size_t, size_t>> CASES = {
+        { "/a x\x80y", 4, 5 },                  // stray continuation byte
+        { "/a \"x\xc3\"", 5, 6 },               // truncated by a quote
+        { "/a x\xe2\x82", 4, 6 },               // truncated by the end
+        { "/a \xc0\xaf", 3, 4 },                // overlong lead
+        { "/a \xe0\x80\xaf", 3, 4 },            // overlong three bytes
+        { "/a \xed\xa0\x80", 3, 4 },            // surrogate
+        { "/a \xf4\x90\x80\x80", 3, 4 },        // above U+10FFFF
+        { "/\xff", 1, 2 },                      // in the key
+        { "/abcdefghijklmnop \xe2\x82\xac\xe2\x28\xa1", 21, 22 },
+    };
+    for (const auto &[input, begin, end] : CASES)
+    {
+        try
+        {
+            ParseParams(input, VALIDATE_UTF8);
+            FAIL() << input;
+        }
+        catch(const UnexpectedValueException& ex)
+        {
+            ASSERT_EQ(begin, ex.GetErrorPosition().begin) << input;
+            ASSERT_EQ(end, ex.GetErrorPosition().end) << input;
+        }
+    }
+}
+
+TEST(EncodingSuite, ValidateParamsUtf8Test)
+{
+    ASSERT_FALSE(ValidateParams("/a \xe2\x82\xac", VALIDATE_UTF8));
+    const auto error = ValidateParams("/a \xe2\x82", VALIDATE_UTF8);
+    ASSERT_TRUE(error);
+    ASSERT_EQ(ParsingErrorKind::UnexpectedValue, error->kind);
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <params_parser/incremental_parser.h>
+#include <params_parser/params_parser.h>
+
+#include <random>
+
+using namespace std;
+
+namespace
+{
+    void ExpectSameAsFullParse(const IncrementalParser& parser)
+    {
+        const auto& text = parser.GetText();
+        const auto error = ValidateParams(text);
+        ASSERT_EQ(error.has_value(), parser.GetError().has_value()) << text;
+        if (error)
+        {
+            ASSERT_EQ(error->kind, parser.GetError()->kind) << text;
+            ASSERT_EQ(error->position.begin, parser.GetError()->position.begin) << text;
+            ASSERT_EQ(error->position.end, parser.GetError()->position.end) << text;
+        }
+        else
+        {
+            ASSERT_EQ(ParseParams(text), parser.GetParams()) << text;
+        }
+
+        const IncrementalParser full(text);
+        const auto spans = parser.GetSpans();
+        const auto expected = full.GetSpans();
+        ASSERT_EQ(expected.size(), spans.size()) << text;
+        for (size_t i = 0; i < spans.size(); ++i)
+        {
+            ASSERT_EQ(expected[i].param.begin, spans[i].param.begin) << text;
+            ASSERT_EQ(expected[i].key.end, spans[i].key.end) << text;
+            ASSERT_EQ(expected[i].value.begin, spans[i].value.begin) << text;
+            ASSERT_EQ(expected[i].value.end, spans[i].value.end) << text;
+        }
+    }
+
+    size_t ReparsedSize(const IncrementalParser& parser)
+    {
+        return parser.GetLastReparsed().end - parser.GetLastReparsed().begin;
+    }
+}
+
+TEST(IncrementalSuite, InitialParseTest)
+{
+    const map<string, string> EXPECTED = {
+        { "name", "Jane Doe" },
+        { "silent", "" }
+    };
+    const IncrementalParser parser("/name \"Jane Doe\" /silent");
+    ASSERT_FALSE(parser.GetError());
+    ASSERT_EQ(EXPECTED, parser.GetParams());
+    ASSERT_EQ(2, parser.GetSpans().size());
+    ASSERT_EQ(0, parser.GetSpans()[0].param.begin);
+    ASSERT_EQ(6, parser.GetSpans()[0].value.begin);
+    ASSERT_EQ(16, parser.GetSpans()[0].value.end);
+}
+
+TEST(IncrementalSuite, TypingTest)
+{
+    IncrementalParser parser;
+    const auto TEXT = "/a 1 /name \"Jane Doe\" /path \\/home\\ dir /c"s;
+    for (size_t i = 0; i < TEXT.size(); ++i)
+    {
+        parser.Edit(i, 0, TEXT.substr(i, 1));
+        ExpectSameAsFullParse(parser);
+    }
+    ASSERT_EQ(TEXT, parser.GetText());
+}
+
+TEST(IncrementalSuite, EditInTheMiddleTest)
+{
+    IncrementalParser parser("/a 1 /b 2 /c 3");
+    parser.Edit(8, 1, "\"two words\"");
+    const map<string, string> EXPECTED = {
+        { "a", "1" },
+        { "b", "two words" },
+        { "c", "3" }
+    };
+    ASSERT_EQ(EXPECTED, parser.GetParams());
+    ASSERT_EQ(20, parser.GetSpans()[2].param.begin);
+}
+
+TEST(IncrementalSuite, ErrorAppearsAndDisappearsTest)
+{
+    IncrementalParser parser("/a 1 /b 2");
+    parser.Edit(5, 2, "/a");
+    ASSERT_TRUE(parser.GetError());
+    ASSERT_EQ(ParsingErrorKind::SpecifiedTwiceParameter, parser.GetError()->kind);
+    parser.Edit(6, 1, "c");
+    ASSERT_FALSE(parser.GetError());
+    parser.Edit(8, 1, "\"2");
+    ASSERT_TRUE(parser.GetError());
+    ASSERT_EQ(ParsingErrorKind::MissingQuotes, parser.GetError()->kind);
+    parser.Edit(10, 0, "\"");
+    ASSERT_FALSE(parser.GetError());
+    ExpectSameAsFullParse(parser);
+}
+
+TEST(IncrementalSuite, RandomEditsTest)
+{
+    const string ALPHABET = "/ab \"\\ ";
+    mt19937 random(42);
+    IncrementalParser parser("/a 1 /b \"x y\" /c \\/d /e");
+    for (int i = 0; i < 3000; ++i)
+    {
+        const auto size = parser.GetText().size();
+        const auto offset = uniform_int_distribution<size_t>(0, size)(random);
+        const auto removed = uniform_int_distribution<size_t>(0, min<size_t>(2, size - offset))(random);
+        string inserted(uniform_int_distribution<size_t>(0, 2)(random), ' ');
+        for (auto& c : inserted)
+        {
+            c = ALPHABET[uniform_int_distribution<size_t>(0, ALPHABET.size() - 1)(random)];
+        }
+        parser.Edit(offset, removed, inserted);
+        ExpectSameAsFullParse(parser);
+        if (parser.GetText().size() > 60)
+        {
+            parser.Edit(0, parser.GetText().size() - 40, "");
+        }
+    }
+}
+
+TEST(IncrementalSuite, LargeInputTest)
+{
+    string text;
+    for (int i = 0; i < 20000; ++i)
+    {
+        text += "/key" + to_string(i) + " \"value " + to_string(i) + "\" ";
+    }
+    IncrementalParser parser(text);
+    ASSERT_EQ(text.size() - 1, ReparsedSize(parser));
+
+    // Each edit parses only the parameters around it, wherever it is in the text.
+    parser.Edit(10, 0, "x");
+    ASSERT_GE(100, ReparsedSize(parser));
+    parser.Edit(text.size() / 2, 0, " /new 1 ");
+    ASSERT_GE(100, ReparsedSize(parser));
+    parser.Edit(text.size() - 20, 3, "");
+    ASSERT_GE(100, ReparsedSize(parser));
+    ExpectSameAsFullParse(parser);
+
+    // A repeated key far from its first occurrence is found without parsing what lies between them.
+    const auto middle = parser.GetSpans()[10000].param.begin;
+    parser.Edit(middle, 0, "/key1 again ");
+    ASSERT_GE(100, ReparsedSize(parser));
+    ASSERT_TRUE(parser.GetError());
+    ASSERT_EQ(ParsingErrorKind::SpecifiedTwiceParameter, parser.GetError()->kind);
+    ExpectSameAsFullParse(parser);
+    parser.Edit(middle + 1, 4, "other");
+    ASSERT_GE(100, ReparsedSize(parser));
+    ASSERT_FALSE(parser.GetError());
+    ExpectSameAsFullParse(parser);
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <params_parser/layered_params.h>
+#include <params_parser/params_parser.h>
+
+using namespace std;
+
+namespace
+{
+    LayeredParams::Layer Parse(const string& params)
+    {
+        return make_shared<const map<string, string>>(ParseParams(params));
+    }
+}
+
+TEST(LayeredSuite, FindFallsThroughTest)
+{
+    const LayeredParams params({
+        Parse("/verbosity quiet /dir default /retries 3"),
+        Parse("/dir config"),
+        Parse("/verbosity debug"),
+    });
+    ASSERT_EQ("debug", *params.Find("verbosity"));
+    ASSERT_EQ("config", *params.Find("dir"));
+    ASSERT_EQ("3", *params.Find("retries"));
+    ASSERT_EQ(nullptr, params.Find("missing"));
+    ASSERT_FALSE(params.Contains("missing"));
+}
+
+TEST(LayeredSuite, IterationTest)
+{
+    const map<string, string> EXPECTED = {
+        { "a", "cmd" },
+        { "b", "defaults" },
+        { "c", "config" },
+        { "d", "cmd" },
+        { "e", "config" }
+    };
+    const LayeredParams params({
+        Parse("/a defaults /b defaults /c defaults"),
+        Parse("/c config /e config"),
+        Parse("/a cmd /d cmd"),
+    });
+    const map<string, string> result(params.begin(), params.end());
+    ASSERT_EQ(EXPECTED, result);
+    ASSERT_EQ(EXPECTED.size(), distance(params.begin(), params.end()));
+}
+
+TEST(LayeredSuite, SharedLayersTest)
+{
+    const auto defaults = Parse("/timeout 30 /user guest");
+    LayeredParams first({defaults});
+    first.PushLayer(Parse("/user alice"));
+    LayeredParams second({defaults});
+    second.PushLayer(Parse("/timeout 5"));
+
+    ASSERT_EQ("alice", *first.Find("user"));
+    ASSERT_EQ("30", *first.Find("timeout"));
+    ASSERT_EQ("guest", *second.Find("user"));
+    ASSERT_EQ("5", *second.Find("timeout"));
+    ASSERT_EQ(&defaults->at("timeout"), first.Find("timeout"));
+}
+
+TEST(LayeredSuite, EmptyTest)
+{
+    const LayeredParams params({Parse(""), Parse("")});
+    ASSERT_TRUE(params.begin() == params.end());
+    ASSERT_TRUE(LayeredParams().begin() == LayeredParams().end());
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <params_parser/params_parser.h>
+#include <params_parser/params_parser_c.h>
+#include <params_parser/parser_exceptions.h>
+
+using namespace std;
+
+namespace
+{
+    ParseOptions WithLimits(const ParseLimits& limits)
+    {
+        return ParseOptions{.limits = limits};
+    }
+
+    string ErrorPart(const string& params, const ParseOptions& options)
+    {
+        try
+        {
+            ParseParams(params, options);
+        }
+        catch(const LimitExceededException& ex)
+        {
+            return ex.GetErrorPart();
+        }
+        return "<no error>";
+    }
+}
+
+TEST(LimitsSuite, WithinLimitsTest)
+{
+    const auto PARAMS = "/name \"Jane Doe\" /path \\/home /silent"s;
+    const auto options = WithLimits({
+        .max_input_bytes = PARAMS.size(),
+        .max_parameters = 3,
+        .max_key_length = 6,
+        .max_value_length = 10,
+        .max_escape_percent = 40,
+    });
+    ASSERT_EQ(ParseParams(PARAMS), ParseParams(PARAMS, options));
+}
+
+TEST(LimitsSuite, InputBytesTest)
+{
+    const auto PARAMS = "/a 1 /b 2"s;
+    try
+    {
+        ParseParams(PARAMS, WithLimits({.max_input_bytes = 4}));
+        FAIL();
+    }
+    catch(const LimitExceededException& ex)
+    {
+        ASSERT_EQ(4, ex.GetErrorPosition().begin);
+        ASSERT_EQ(9, ex.GetErrorPosition().end);
+        ASSERT_EQ("Parsing limit exceeded at [5, 9] in \"" + PARAMS + "\"", ex.what());
+    }
+}
+
+TEST(LimitsSuite, EachLimitTest)
+{
+    ASSERT_EQ("/", ErrorPart("/a /b /c", WithLimits({.max_parameters = 2})));
+    ASSERT_EQ("long_key", ErrorPart("/k 1 /long_key 2", WithLimits({.max_key_length = 4})));
+    ASSERT_EQ("\"a b c\"", ErrorPart("/k \"a b c\"", WithLimits({.max_value_length = 5})));
+    ASSERT_EQ("\\/\\/x", ErrorPart("/k ab\\/ /m \\/\\/x", WithLimits({.max_escape_percent = 50})));
+}
+
+TEST(LimitsSuite, OtherEntryPointsTest)
+{
+    const auto options = WithLimits({.max_parameters = 1});
+    const auto error = ValidateParams("/a 1 /b 2", options);
+    ASSERT_TRUE(error);
+    ASSERT_EQ(ParsingErrorKind::LimitExceeded, error->kind);
+
+    const auto recovered = ParseParamsRecovering("/a 1 x /b 2 /c 3", options);
+    ASSERT_EQ(2, recovered.errors.size());
+    ASSERT_EQ(ParsingErrorKind::UnexpectedValue, recovered.errors[0].kind);
+    ASSERT_EQ(ParsingErrorKind::LimitExceeded, recovered.errors[1].kind);
+    ASSERT_EQ(1, recovered.params.size());
+
+    const auto oversized = ParseParamsRecovering("/a 1", WithLimits({.max_input_bytes = 2}));
+    ASSERT_EQ(1, oversized.errors.size());
+    ASSERT_EQ(ParsingErrorKind::LimitExceeded, oversized.errors[0].kind);
+}
+
+TEST(LimitsSuite, CApiTest)
+{
+    const auto INPUT = "/a 1 /bb 2"s;
+    auto limits = pp_default_limits();
+    limits.max_key_length = 1;
+    vector<pp_entry> entries(4);
+    string buffer(16, '\0');
+    pp_result result;
+    ASSERT_EQ(PP_LIMIT_EXCEEDED, pp_parse_limited(INPUT.data(), INPUT.size(), 0, &limits, entries.data(),
+                                                  entries.size(), buffer.data(), buffer.size(), &result));
+    ASSERT_EQ(6, result.error_begin);
+    ASSERT_EQ(8, result.error_end);
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <params_parse/pipeline.h>
+
+#include <cstdio>
+
+using namespace std;
+
+namespace
+{
+    struct Converted
+    {
+        string output;
+        string errors;
+        Totals totals;
+    };
+
+    string ReadAll(FILE* file)
+    {
+        rewind(file);
+        string text;
+        char buffer[4096];
+        while (const auto read = fread(buffer, 1, sizeof(buffer), file))
+        {
+            text.append(buffer, read);
+        }
+        fclose(file);
+        return text;
+    }
+
+    Converted Convert(const string& input, Format format, unsigned workers, size_t block_size)
+    {
+        FILE* in = tmpfile();
+        FILE* out = tmpfile();
+        FILE* errors = tmpfile();
+        fwrite(input.data(), 1, input.size(), in);
+        rewind(in);
+        const auto totals = ConvertStream(in, out, errors, format, workers, block_size);
+        fclose(in);
+        return Converted{ReadAll(out), ReadAll(errors), totals};
+    }
+
+    string NumberedLines(size_t count)
+    {
+        string lines;
+        for (size_t i = 0; i < count; ++i)
+        {
+            lines += "/n " + to_string(i) + " /pad \"" + string(i % 13, 'x') + "\"\n";
+        }
+        return lines;
+    }
+}
+
+TEST(PipelineSuite, JsonTest)
+{
+    const auto result = Convert("/b 2 /a \"x y\"\n\n/c \"open\n", Format::Json, 1, BLOCK_SIZE);
+    ASSERT_EQ("{\"a\":\"x y\",\"b\":\"2\"}\n{}\nnull\n", result.output);
+    ASSERT_EQ(3, result.totals.lines);
+    ASSERT_EQ(1, result.totals.failed_lines);
+    ASSERT_EQ(0, result.errors.rfind("line 3: ", 0));
+}
+
+TEST(PipelineSuite, JsonEscapingTest)
+{
+    const auto result = Convert("/q \"say \\\"hi\\\"\" /s \\\\ /t \"a\tb\" /u \"\x01\"\n", Format::Json, 1, BLOCK_SIZE);
+    ASSERT_EQ("{\"q\":\"say \\\"hi\\\"\",\"s\":\"\\\\\",\"t\":\"a\\tb\",\"u\":\"\\u0001\"}\n", result.output);
+}
+
+TEST(PipelineSuite, JsonInvalidUtf8Test)
+{
+    const auto result = Convert("/a \xff\n/b \"\xc3\xa9\"\n", Format::Json, 1, BLOCK_SIZE);
+    ASSERT_EQ("null\n{\"b\":\"\xc3\xa9\"}\n", result.output);
+    ASSERT_EQ(1, result.totals.failed_lines);
+    ASSERT_EQ(0, result.errors.rfind("line 1: ", 0));
+}
+
+TEST(PipelineSuite, TsvEscapingTest)
+{
+    const auto result = Convert("/a \"x\ty\" /b \\\\\n/c \"\r\"\n", Format::Tsv, 1, BLOCK_SIZE);
+    ASSERT_EQ("1\ta\tx\\ty\n1\tb\t\\\\\n2\tc\t\\r\n", result.output);
+}
+
+TEST(PipelineSuite, LastLineWithoutNewlineTest)
+{
+    const auto result = Convert("/a 1\n/b 2", Format::Json, 1, BLOCK_SIZE);
+    ASSERT_EQ("{\"a\":\"1\"}\n{\"b\":\"2\"}\n", result.output);
+    ASSERT_EQ(2, result.totals.lines);
+}
+
+TEST(PipelineSuite, LinesLongerThanBlockTest)
+{
+    // Every read ends inside a line, so each block is made of lines carried over from earlier reads.
+    const auto INPUT = NumberedLines(50);
+    const auto whole = Convert(INPUT, Format::Tsv, 1, BLOCK_SIZE);
+    for (const size_t block_size : {1, 3, 7, 16})
+    {
+        const auto split = Convert(INPUT, Format::Tsv, 1, block_size);
+        ASSERT_EQ(whole.output, split.output) << "block size " << block_size;
+        ASSERT_EQ(INPUT.size(), split.totals.bytes);
+        ASSERT_EQ(50, split.totals.lines);
+    }
+}
+
+TEST(PipelineSuite, WorkersKeepInputOrderTest)
+{
+    const auto INPUT = NumberedLines(2000) + "/broken \"\n" + NumberedLines(10);
+    const auto single = Convert(INPUT, Format::Json, 1, BLOCK_SIZE);
+    for (const unsigned workers : {2, 4, 8})
+    {
+        const auto parallel = Convert(INPUT, Format::Json, workers, 64);
+        ASSERT_EQ(single.output, parallel.output) << workers << " workers";
+        ASSERT_EQ(single.errors, parallel.errors) << workers << " workers";
+        ASSERT_EQ(1, parallel.totals.failed_lines);
+    }
+    ASSERT_EQ("line 2001: ", single.errors.substr(0, 11));
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <params_parser/params_parser.h>
+#include <params_parser/parser_exceptions.h>
+
+using namespace std;
+
+namespace
+{
+    vector<pair<ParsingErrorKind, string>> Describe(const string& params, const vector<ParsingError>& errors)
+    {
+        vector<pair<ParsingErrorKind, string>> result;
+        for (const auto& error : errors)
+        {
+            result.emplace_back(error.kind, params.substr(error.position.begin, error.position.end - error.position.begin));
+        }
+        return result;
+    }
+}
+
+TEST(RecoverySuite, ValidInputTest)
+{
+    const auto PARAMS = "/silent /name \"Jane Doe\""s;
+    const auto result = ParseParamsRecovering(PARAMS);
+    ASSERT_TRUE(result.errors.empty());
+    ASSERT_EQ(ParseParams(PARAMS), result.params);
+}
+
+TEST(RecoverySuite, AllErrorKindsTest)
+{
+    const auto PARAMS = "stray /a 1 / 2 /b x y /a 3 /c\"q\" /d 4 /e \"open"s;
+    const map<string, string> EXPECTED_PARAMS = {
+        { "a", "1" },
+        { "b", "x" },
+        { "d", "4" }
+    };
+    const vector<pair<ParsingErrorKind, string>> EXPECTED_ERRORS = {
+        { ParsingErrorKind::UnexpectedValue, "stray" },
+        { ParsingErrorKind::MissingParameterName, "/" },
+        { ParsingErrorKind::UnexpectedValue, "y" },
+        { ParsingErrorKind::SpecifiedTwiceParameter, "/a" },
+        { ParsingErrorKind::UnexpectedValue, "\"" },
+        { ParsingErrorKind::MissingQuotes, "\"open" },
+    };
+    const auto result = ParseParamsRecovering(PARAMS);
+    ASSERT_EQ(EXPECTED_PARAMS, result.params);
+    ASSERT_EQ(EXPECTED_ERRORS, Describe(PARAMS, result.errors));
+}
+
+TEST(RecoverySuite, FirstErrorMatchesParseParamsTest)
+{
+    const vector<string> INPUTS = {
+        "/first 1 / 2",
+        "/verbosity quiet something else",
+        "/name \"Jane Doe\" \"Default City\"",
+        "/verbosity debug /verbosity quiet",
+        "/name \"Jane Doe",
+        "/name \"Jane Doe /city \"Default City\"",
+    };
+    for (const auto& input : INPUTS)
+    {
+        const auto result = ParseParamsRecovering(input);
+        const auto error = ValidateParams(input);
+        ASSERT_FALSE(result.errors.empty()) << input;
+        ASSERT_EQ(error->kind, result.errors.front().kind) << input;
+        ASSERT_EQ(error->position.begin, result.errors.front().position.begin) << input;
+        ASSERT_EQ(error->position.end, result.errors.front().position.end) << input;
+    }
+}
+
+TEST(RecoverySuite, InvalidUtf8Test)
+{
+    const auto PARAMS = "\xff /a \x80 /b 2 /c x\xc3"s;
+    const map<string, string> EXPECTED_PARAMS = {
+        { "b", "2" }
+    };
+    const vector<pair<ParsingErrorKind, string>> EXPECTED_ERRORS = {
+        { ParsingErrorKind::UnexpectedValue, "\xff" },
+        { ParsingErrorKind::UnexpectedValue, "\x80" },
+        { ParsingErrorKind::UnexpectedValue, "\xc3" },
+    };
+    const auto result = ParseParamsRecovering(PARAMS, {.validate_utf8 = true, .limits = {}});
+    ASSERT_EQ(EXPECTED_PARAMS, result.params);
+    ASSERT_EQ(EXPECTED_ERRORS, Describe(PARAMS, result.errors));
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <params_parser/params_parser.h>
+#include <params_parser/parser_exceptions.h>
+
+using namespace std;
+
+TEST(SelectionSuite, SelectedOnlyTest)
+{
+    const map<string, string> EXPECTED = {
+        { "name", "Jane Doe" },
+        { "reboot", "" }
+    };
+    const auto result = ParseSelectedParams(
+        "/silent /name \"Jane Doe\" /path C:\\Program\\ Files /reboot",
+        {"name", "reboot"}
+    );
+    ASSERT_EQ(EXPECTED, result);
+}
+
+TEST(SelectionSuite, MissingSelectedParamTest)
+{
+    const map<string, string> EXPECTED = {
+        { "a", "1" }
+    };
+    const auto result = ParseSelectedParams("/a 1 /b 2", {"a", "c"});
+    ASSERT_EQ(EXPECTED, result);
+}
+
+TEST(SelectionSuite, EscapedValuesTest)
+{
+    const map<string, string> EXPECTED = {
+        { "r", R"(/a "\/" /b)" }
+    };
+    const auto result = ParseSelectedParams(R"(/q "\"" /r "/a \"\\/\" /b")", {"r"});
+    ASSERT_EQ(EXPECTED, result);
+}
+
+TEST(SelectionSuite, StrictModeReportsSkippedDuplicatesTest)
+{
+    const auto PARAMS = "/wanted 1 /skipped a /skipped b"s;
+    try
+    {
+        ParseSelectedParams(PARAMS, {"wanted"});
+        FAIL();
+    }
+    catch(const SpecifiedTwiceParameterException& ex)
+    {
+        ASSERT_EQ("/skipped", ex.GetErrorPart());
+    }
+}
+
+TEST(SelectionSuite, StrictModeReportsErrorsAfterSelectedTest)
+{
+    ASSERT_THROW(ParseSelectedParams("/wanted 1 /skipped \"open", {"wanted"}), MissingQuotesException);
+    ASSERT_THROW(ParseSelectedParams("/wanted 1 / 2", {"wanted"}), MissingParameterNameException);
+}
+
+TEST(SelectionSuite, StopWhenFoundIgnoresRestTest)
+{
+    const map<string, string> EXPECTED = {
+        { "a", "1" },
+        { "b", "2" }
+    };
+    const auto result = ParseSelectedParams("/b 2 /a 1 /a 3 \"unterminated", {"a", "b"}, SelectionMode::StopWhenFound);
+    ASSERT_EQ(EXPECTED, result);
+}
+
+TEST(SelectionSuite, StopWhenFoundReportsErrorsBeforeTest)
+{
+    ASSERT_THROW(ParseSelectedParams("/b x y /a 1", {"a"}, SelectionMode::StopWhenFound), UnexpectedValueException);
+    ASSERT_THROW(ParseSelectedParams("/a 1 /a 2", {"a", "b"}, SelectionMode::StopWhenFound),
+                 SpecifiedTwiceParameterException);
+}
+
+TEST(SelectionSuite, StopWhenFoundRepeatedKeysTest)
+{
+    const map<string, string> EXPECTED = {
+        { "a", "1" }
+    };
+    const auto result = ParseSelectedParams("/a 1 \"unterminated", {"a", "a"}, SelectionMode::StopWhenFound);
+    ASSERT_EQ(EXPECTED, result);
+}
+
+TEST(SelectionSuite, StopWhenFoundNoKeysTest)
+{
+    ASSERT_TRUE(ParseSelectedParams("\"unterminated", {}, SelectionMode::StopWhenFound).empty());
+    ASSERT_THROW(ParseSelectedParams("\"unterminated", {}), MissingQuotesException);
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <params_parser/params_parser.h>
+#include <params_parser/parser_exceptions.h>
+
+using namespace std;
+
+TEST(SyntaxSuite, SlashSyntaxIsDefaultTest)
+{
+    const auto PARAMS = "/silent /name \"Jane Doe\" /path \\/home\\ dir"s;
+    ASSERT_EQ(ParseParams(PARAMS), ParseParamsAs<SlashSyntax>(PARAMS));
+}
+
+TEST(SyntaxSuite, DoubleDashTest)
+{
+    const map<string, string> EXPECTED = {
+        { "silent", "" },
+        { "name", "Jane Doe" },
+        { "my-key", "a=b" },
+        { "path", "C:\\Program Files" },
+        { "range", "1--2" },
+        { "empty", "" }
+    };
+    const auto result = ParseParamsAs<DoubleDashSyntax>(
+        "--silent --name=\"Jane Doe\" --my-key=a=b --path=C:\\Program\\ Files --range=1\\--2 --empty="
+    );
+    ASSERT_EQ(EXPECTED, result);
+}
+
+TEST(SyntaxSuite, DashColonTest)
+{
+    const map<string, string> EXPECTED = {
+        { "verbose", "" },
+        { "time", "12:30" },
+        { "name", "Jane Doe" },
+        { "offset", "-5" }
+    };
+    const auto result = ParseParamsAs<DashColonSyntax>("-verbose -time:12:30 -name:\"Jane Doe\" -offset:\\-5");
+    ASSERT_EQ(EXPECTED, result);
+}
+
+TEST(SyntaxSuite, PrefixAfterSeparatorTest)
+{
+    const map<string, string> DASH_COLON = {
+        { "offset", "-5" },
+        { "range", "--1:-2" },
+        { "empty", "" },
+        { "next", "" }
+    };
+    ASSERT_EQ(DASH_COLON, ParseParamsAs<DashColonSyntax>("-offset:-5 -range:--1:-2 -empty: -next"));
+
+    const map<string, string> DOUBLE_DASH = {
+        { "a", "--b" }
+    };
+    ASSERT_EQ(DOUBLE_DASH, ParseParamsAs<DoubleDashSyntax>("--a=--b"));
+
+    const map<string, string> SLASH = {
+        { "a", "" },
+        { "b", "" }
+    };
+    ASSERT_EQ(SLASH, ParseParams("/a /b"));
+}
+
+TEST(SyntaxSuite, DialectErrorsTest)
+{
+    ASSERT_THROW(ParseParamsAs<DoubleDashSyntax>("--a=1 stray"), UnexpectedValueException);
+    ASSERT_THROW(ParseParamsAs<DoubleDashSyntax>("--a=\"open"), MissingQuotesException);
+    ASSERT_THROW(ParseParamsAs<DoubleDashSyntax>("--=1"), MissingParameterNameException);
+    ASSERT_THROW(ParseParamsAs<DoubleDashSyntax>("--a\"x\""), UnexpectedValueException);
+
+    try
+    {
+        ParseParamsAs<DoubleDashSyntax>("--key=1 --key=2");
+        FAIL();
+    }
+    catch(const SpecifiedTwiceParameterException& ex)
+    {
+        ASSERT_EQ("--key", ex.GetErrorPart());
+    }
+
+    const auto error = ValidateParamsAs<DashColonSyntax>("-a:1 -a:2");
+    ASSERT_TRUE(error);
+    ASSERT_EQ(ParsingErrorKind::SpecifiedTwiceParameter, error->kind);
+    ASSERT_EQ(5, error->position.begin);
+    ASSERT_EQ(7, error->position.end);
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include <params_parser/params_parser.h>
+#include <params_parser/parser_exceptions.h>
+
+using namespace std;
+
+TEST(ValidationSuite, ValidInputTest)
+{
+    ASSERT_FALSE(ValidateParams(""));
+    ASSERT_FALSE(ValidateParams("/silent /name \"Jane Doe\" /path \\/home\\ dir /q \"\\\"\""));
+}
+
+TEST(ValidationSuite, ErrorKindsTest)
+{
+    const auto missing_name = ValidateParams("/first 1 / 2");
+    ASSERT_TRUE(missing_name);
+    ASSERT_EQ(ParsingErrorKind::MissingParameterName, missing_name->kind);
+
+    const auto unexpected = ValidateParams("/verbosity quiet something else");
+    ASSERT_TRUE(unexpected);
+    ASSERT_EQ(ParsingErrorKind::UnexpectedValue, unexpected->kind);
+
+    const auto twice = ValidateParams("/verbosity debug /verbosity quiet");
+    ASSERT_TRUE(twice);
+    ASSERT_EQ(ParsingErrorKind::SpecifiedTwiceParameter, twice->kind);
+
+    const auto quotes = ValidateParams("/name \"Jane Doe");
+    ASSERT_TRUE(quotes);
+    ASSERT_EQ(ParsingErrorKind::MissingQuotes, quotes->kind);
+}
+
+TEST(ValidationSuite, SameErrorAsParseParamsTest)
+{
+    const vector<string> INPUTS = {
+        "/first 1 / 2",
+        "/verbosity quiet something else",
+        "/name \"Jane Doe\" \"Default City\"",
+        "/verbosity debug /verbosity quiet",
+        "/name \"Jane Doe",
+        "/name \"Jane Doe /city \"Default City\"",
+        "/key\"value\"",
+        "value",
+    };
+    for (const auto &input : INPUTS)
+    {
+        const auto error = ValidateParams(input);
+        ASSERT_TRUE(error) << input;
+        try
+        {
+            ParseParams(input);
+            FAIL() << input;
+        }
+        catch(const ParsingException& ex)
+        {
+            ASSERT_EQ(ex.GetErrorKind(), error->kind) << input;
+            ASSERT_EQ(ex.GetErrorPosition().begin, error->position.begin) << input;
+            ASSERT_EQ(ex.GetErrorPosition().end, error->position.end) << input;
+        }
+    }
+}